@@ -2,17 +2,247 @@
 #include <algorithm>
 #include <functional>  // For std::greater in priority_queue
 #include <memory>      // For std::unique_ptr
+#include <climits>
+#include <cstdlib>
+
+namespace {
+    // Binary heap over integer f; on ties prefer the deeper node, which reaches the goal sooner
+    template <typename Node>
+    class HeapOpenList {
+    private:
+        std::vector<Node>& heap;
+        static bool worse(const Node& a, const Node& b) { return a.f > b.f || (a.f == b.f && a.g < b.g); }
+    public:
+        explicit HeapOpenList(std::vector<Node>& storage) : heap(storage) { heap.clear(); }
+        bool empty() const { return heap.empty(); }
+        size_t size() const { return heap.size(); }
+        int topKey() const { return heap.front().f; }
+        void push(const Node& n) {
+            heap.push_back(n);
+            std::push_heap(heap.begin(), heap.end(), worse);
+        }
+        Node pop() {
+            std::pop_heap(heap.begin(), heap.end(), worse);
+            Node n = heap.back();
+            heap.pop_back();
+            return n;
+        }
+    };
+
+    // Bucket per f value; LIFO within a bucket gives the same deeper-first tie-breaking
+    template <typename Node>
+    class BucketOpenList {
+    private:
+        BucketQueue<Node>& queue;
+    public:
+        explicit BucketOpenList(BucketQueue<Node>& storage) : queue(storage) { queue.clear(); }
+        bool empty() const { return queue.empty(); }
+        void push(const Node& n) { queue.push(n.f, n); }
+        Node pop() { return queue.pop(); }
+    };
+
+    // Cost of stepping onto cell i: always 1, or the maze's terrain cost
+    struct UnitCost {
+        int operator()(int) const { return 1; }
+    };
+    struct CellCost {
+        const Maze& maze;
+        int operator()(int i) const { return maze.moveCost(i); }
+    };
+    // A step-counting distance times the cheapest step is still a consistent
+    // bound on weighted cells, and exact where every open cell costs the same
+    template <typename Distance>
+    struct ScaledDistance {
+        Distance distance;
+        int scale;
+        int operator()(Point a, Point b) const { return distance(a, b) * scale; }
+    };
+
+    // Jump points for 4-connected JPS. Canonical paths move vertically first and only
+    // turn horizontally where that is forced, so a horizontal run stops where a
+    // vertical neighbour opens up next to a blocked one, and a vertical run stops
+    // wherever a horizontal run from it would find a jump point.
+    bool jumpHorizontal(const Maze& maze, Point from, int dx, Point goal, Point& jumpPoint) {
+        Point p = from;
+        while (true) {
+            p.x += dx;
+            if (maze.isWall(p)) return false;
+            if (p == goal ||
+                (!maze.isWall({ p.x, p.y - 1 }) && maze.isWall({ p.x - dx, p.y - 1 })) ||
+                (!maze.isWall({ p.x, p.y + 1 }) && maze.isWall({ p.x - dx, p.y + 1 }))) {
+                jumpPoint = p;
+                return true;
+            }
+        }
+    }
+
+    bool jumpVertical(const Maze& maze, Point from, int dy, Point goal, Point& jumpPoint) {
+        Point p = from;
+        Point ignored;
+        while (true) {
+            p.y += dy;
+            if (maze.isWall(p)) return false;
+            if (p == goal ||
+                jumpHorizontal(maze, p, 1, goal, ignored) ||
+                jumpHorizontal(maze, p, -1, goal, ignored)) {
+                jumpPoint = p;
+                return true;
+            }
+        }
+    }
+
+    // Online jumps, interchangeable with the precomputed JumpTable
+    struct ScanJumper {
+        const Maze& maze;
+        bool jump(Point p, int dx, int dy, Point goal, Point& jumpPoint) const {
+            return dy == 0 ? jumpHorizontal(maze, p, dx, goal, jumpPoint) : jumpVertical(maze, p, dy, goal, jumpPoint);
+        }
+    };
+
+    int sign(int v) { return (v > 0) - (v < 0); }
+
+    // Random and open maps settle within a handful of sweeps; a maze that
+    // needs more is cheaper to finish with a BFS
+    const int FLOOD_SWEEPS = 32;
+}
 
 PathFinder::PathFinder() {
-    heuristic = std::make_unique<ManhattanHeuristic>();
+    heuristic = makeHeuristic(heuristicKind);
+}
+
+void PathFinder::setHeuristic(HeuristicKind kind) {
+    heuristicKind = kind;
+    heuristic = makeHeuristic(kind);
+    landmarks = kind == HeuristicKind::LANDMARK ? static_cast<LandmarkHeuristic*>(heuristic.get()) : nullptr;
+}
+
+// Calls search with the distance functor for the selected kind, so each kind gets
+// its own instantiation of the search loop
+template <typename Search>
+bool PathFinder::withHeuristic(Search&& search) {
+    switch (heuristicKind) {
+    case HeuristicKind::ZERO: return search(ZeroDistance{});
+    case HeuristicKind::OCTILE: return search(OctileDistance{});
+    case HeuristicKind::LANDMARK: return search(LandmarkDistance{ landmarks });
+    default: return search(ManhattanDistance{});
+    }
+}
+
+// Same idea for tracing: without a trace the search gets the empty recorder
+template <typename Search>
+bool PathFinder::withRecorder(Search&& search) {
+    if (trace) return search(*trace);
+    NoTrace none;
+    return search(none);
+}
+
+void PathFinder::clearExplored() {
+    // Keeps the word storage, so the next search's reset does not reallocate
+    explored.reset(0, 0);
+    exploredPending = false;
+    exploredReverse = false;
+}
+
+const GridBitmap& PathFinder::getExplored() const {
+    if (exploredPending) {
+        exploredPending = false;
+        int height = static_cast<int>(buffers.closed.size()) / exploredWidth;
+        explored.reset(exploredWidth, height);
+        for (int y = 0, i = 0; y < height; ++y) {
+            for (int x = 0; x < exploredWidth; ++x, ++i) {
+                if (buffers.isClosed(i) || (exploredReverse && reverseBuffers.isClosed(i))) explored.set(x, y, true);
+            }
+        }
+    }
+    return explored;
 }
 
 std::vector<Point> PathFinder::findPath(Maze* maze) {
-    explored.clear();
+    clearExplored();
     if (!maze) return {};
-    if (!maze->isValid(maze->startPos) || !maze->isValid(maze->endPos)) return {};
-    if (maze->startPos == maze->endPos) return { maze->startPos };
+    if (!findPath(*maze, maze->startPos, maze->endPos, pathScratch)) return {};
+    return pathScratch;
+}
+
+bool PathFinder::findPath(Maze* maze, CompactPath& outPath) {
+    outPath.clear();
+    clearExplored();
+    if (!maze) return false;
+    if (!findPath(*maze, maze->startPos, maze->endPos, pathScratch)) return false;
+    outPath.assign(pathScratch);
+    return true;
+}
+
+bool PathFinder::findPath(const Maze& maze, Point start, Point goal, std::vector<Point>& outPath) {
+    clearExplored();
+    stats = SearchStats{};
+    outPath.clear();
+    // Begun before the early returns, so a replay never shows an older search
+    if (trace) trace->begin(maze.width, maze.height);
+    if (!maze.isValid(start) || !maze.isValid(goal)) return false;
+    if (start == goal) {
+        outPath.push_back(start);
+        return true;
+    }
+    if (landmarks) landmarks->update(maze);
+
+    if (mode == SearchMode::INDEXED_ASTAR) {
+        return withHeuristic([&](auto distance) {
+            HeapOpenList<OpenNode> open(openHeap);
+            return withRecorder([&](auto& record) { return findPathIndexed(open, distance, UnitCost{}, record, maze, start, goal, outPath); });
+        });
+    }
+    if (mode == SearchMode::BUCKET_ASTAR) {
+        return withHeuristic([&](auto distance) {
+            BucketOpenList<OpenNode> open(openBuckets);
+            return withRecorder([&](auto& record) { return findPathIndexed(open, distance, UnitCost{}, record, maze, start, goal, outPath); });
+        });
+    }
+    if (mode == SearchMode::WEIGHTED_ASTAR && !maze.isWeighted()) {
+        // Every cost is 1: the bucket search finds the same path without reading them
+        return withHeuristic([&](auto distance) {
+            BucketOpenList<OpenNode> open(openBuckets);
+            return withRecorder([&](auto& record) { return findPathIndexed(open, distance, UnitCost{}, record, maze, start, goal, outPath); });
+        });
+    }
+    if (mode == SearchMode::WEIGHTED_ASTAR) {
+        int scale = maze.cheapestCost();
+        return withHeuristic([&](auto distance) {
+            ScaledDistance<decltype(distance)> scaled{ distance, scale };
+            BucketOpenList<OpenNode> open(openBuckets);
+            return withRecorder([&](auto& record) { return findPathIndexed(open, scaled, CellCost{ maze }, record, maze, start, goal, outPath); });
+        });
+    }
+    if (mode == SearchMode::JPS) {
+        return withHeuristic([&](auto distance) {
+            BucketOpenList<OpenNode> open(openBuckets);
+            return withRecorder([&](auto& record) { return findPathJump(open, ScanJumper{ maze }, distance, record, maze, start, goal, outPath); });
+        });
+    }
+    if (mode == SearchMode::JPS_PLUS) {
+        jumpTable.attach(maze);
+        return withHeuristic([&](auto distance) {
+            BucketOpenList<OpenNode> open(openBuckets);
+            return withRecorder([&](auto& record) { return findPathJump(open, jumpTable, distance, record, maze, start, goal, outPath); });
+        });
+    }
+    if (mode == SearchMode::LPA_STAR) {
+        incremental.attach(maze);
+        bool found = incremental.findPath(start, goal, outPath, trace);
+        // Only the repaired cells count as explored for this query
+        explored.reset(maze.width, maze.height);
+        for (int i : incremental.getExpanded()) explored.set(i % maze.width, i / maze.width, true);
+        stats.expanded = static_cast<int>(incremental.getExpanded().size());
+        return found;
+    }
+    if (mode == SearchMode::BIDIRECTIONAL_BFS) return findPathBidirectionalBFS(maze, start, goal, outPath);
+    if (mode == SearchMode::BIDIRECTIONAL_ASTAR) {
+        return withHeuristic([&](auto distance) { return findPathBidirectionalAStar(distance, maze, start, goal, outPath); });
+    }
+    return findPathClassic(maze, start, goal, outPath);
+}
 
+bool PathFinder::findPathClassic(const Maze& maze, Point start, Point goal, std::vector<Point>& outPath) {
     struct PQNode { float f; Point pos; };
     struct PQComp { bool operator()(PQNode const& a, PQNode const& b) const { return a.f > b.f; } };
 
@@ -22,10 +252,11 @@ std::vector<Point> PathFinder::findPath(Maze* maze) {
 
     gScore.reserve(1024);
     cameFrom.reserve(1024);
+    explored.reset(maze.width, maze.height);
 
-    float h0 = heuristic->calculate(maze->startPos, maze->endPos);
-    gScore[maze->startPos] = 0.0f;
-    open.push({ h0, maze->startPos });
+    float h0 = heuristic->calculate(start, goal);
+    gScore[start] = 0.0f;
+    open.push({ h0, start });
 
     Point directions[4] = { {0,1},{0,-1},{1,0},{-1,0} };
 
@@ -36,42 +267,304 @@ std::vector<Point> PathFinder::findPath(Maze* maze) {
         auto git = gScore.find(current);
         if (git == gScore.end()) continue;
         float currentG = git->second;
-        float expectedF = currentG + heuristic->calculate(current, maze->endPos);
+        float expectedF = currentG + heuristic->calculate(current, goal);
         if (top.f > expectedF + 1e-6f) continue;
 
-        explored.insert(current);
+        explored.set(current.x, current.y, true);
+        stats.expanded++;
 
-        if (current == maze->endPos) {
-            std::vector<Point> path;
+        if (current == goal) {
             Point p = current;
-            path.push_back(p);
+            outPath.push_back(p);
             while (cameFrom.find(p) != cameFrom.end()) {
                 p = cameFrom[p];
-                path.push_back(p);
+                outPath.push_back(p);
             }
-            std::reverse(path.begin(), path.end());
-            return path;
+            std::reverse(outPath.begin(), outPath.end());
+            return true;
         }
 
         for (Point dir : directions) {
             Point neighbor = { current.x + dir.x, current.y + dir.y };
-            if (!maze->isValid(neighbor) || maze->isWall(neighbor)) continue;
+            if (!maze.isValid(neighbor) || maze.isWall(neighbor)) continue;
 
             float tentativeG = currentG + 1.0f;
             auto ngIt = gScore.find(neighbor);
             if (ngIt == gScore.end() || tentativeG + 1e-6f < ngIt->second) {
                 cameFrom[neighbor] = current;
                 gScore[neighbor] = tentativeG;
-                float f = tentativeG + heuristic->calculate(neighbor, maze->endPos);
+                float f = tentativeG + heuristic->calculate(neighbor, goal);
                 open.push({ f, neighbor });
+                stats.pushed++;
+            }
+        }
+    }
+
+    return false;
+}
+
+template <typename OpenList, typename Heuristic, typename StepCost, typename Recorder>
+bool PathFinder::findPathIndexed(OpenList& open, Heuristic distance, StepCost cost, Recorder& record, const Maze& maze, Point start, Point goal, std::vector<Point>& outPath) {
+    buffers.prepare(maze.cellCount());
+    exploredWidth = maze.width;
+    exploredPending = true;
+
+    // Integer edge costs plus an integer heuristic keep every f an integer
+    auto h = [&](Point p) { return distance(p, goal); };
+
+    int startIndex = maze.index(start.x, start.y);
+    int goalIndex = maze.index(goal.x, goal.y);
+    buffers.open(startIndex, 0, -1);
+    open.push({ h(start), 0, startIndex, start });
+    record.push(startIndex, 0);
+
+    Point directions[4] = { {0,1},{0,-1},{1,0},{-1,0} };
+    int offsets[4] = { maze.width, -maze.width, 1, -1 };
+
+    while (!open.empty()) {
+        OpenNode top = open.pop();
+
+        // g only ever decreases, so an entry is stale exactly when a cheaper one was pushed
+        if (buffers.isClosed(top.index) || top.g != buffers.gCost[top.index]) continue;
+        buffers.close(top.index);
+        record.expand(top.index, top.g);
+        stats.expanded++;
+
+        if (top.index == goalIndex) {
+            for (int i = goalIndex; i != -1; i = buffers.parent[i]) {
+                outPath.push_back({ i % maze.width, i / maze.width });
+            }
+            std::reverse(outPath.begin(), outPath.end());
+            return true;
+        }
+
+        for (int d = 0; d < 4; ++d) {
+            Point neighbor = { top.pos.x + directions[d].x, top.pos.y + directions[d].y };
+            if (maze.isWall(neighbor)) continue;
+
+            int n = top.index + offsets[d];
+            int tentativeG = top.g + cost(n);
+            if (buffers.isSeen(n) && buffers.gCost[n] <= tentativeG) continue;
+
+            buffers.open(n, tentativeG, top.index);
+            open.push({ tentativeG + h(neighbor), tentativeG, n, neighbor });
+            record.push(n, tentativeG);
+            stats.pushed++;
+        }
+    }
+
+    return false;
+}
+
+template <typename OpenList, typename Jumper, typename Heuristic, typename Recorder>
+bool PathFinder::findPathJump(OpenList& open, const Jumper& jumper, Heuristic distance, Recorder& record, const Maze& maze, Point start, Point goal, std::vector<Point>& outPath) {
+    buffers.prepare(maze.cellCount());
+    exploredWidth = maze.width;
+    exploredPending = true;
+
+    // Jump edges are straight runs, so their cost is the Manhattan distance
+    auto h = [&](Point p) { return distance(p, goal); };
+
+    int startIndex = maze.index(start.x, start.y);
+    int goalIndex = maze.index(goal.x, goal.y);
+    buffers.open(startIndex, 0, -1);
+    open.push({ h(start), 0, startIndex, start });
+    record.push(startIndex, 0);
+
+    while (!open.empty()) {
+        OpenNode top = open.pop();
+        if (buffers.isClosed(top.index) || top.g != buffers.gCost[top.index]) continue;
+        buffers.close(top.index);
+        record.expand(top.index, top.g);
+        stats.expanded++;
+
+        if (top.index == goalIndex) {
+            // Unroll the straight segments between jump points into single steps
+            Point p = goal;
+            outPath.push_back(p);
+            for (int i = buffers.parent[goalIndex]; i != -1; i = buffers.parent[i]) {
+                Point jp = { i % maze.width, i / maze.width };
+                int dx = sign(jp.x - p.x), dy = sign(jp.y - p.y);
+                while (p != jp) {
+                    p = { p.x + dx, p.y + dy };
+                    outPath.push_back(p);
+                }
+            }
+            std::reverse(outPath.begin(), outPath.end());
+            return true;
+        }
+
+        // Prune to the canonical successors for the direction we arrived from
+        int dx = 0, dy = 0;
+        int from = buffers.parent[top.index];
+        if (from != -1) {
+            dx = sign(top.pos.x - from % maze.width);
+            dy = sign(top.pos.y - from / maze.width);
+        }
+
+        Point jumps[4];
+        int jumpCount = 0;
+        Point jp;
+        if (dy == 0) {
+            // Start or horizontal arrival: keep going and try both vertical turns
+            if (dx != -1 && jumper.jump(top.pos, 1, 0, goal, jp)) jumps[jumpCount++] = jp;
+            if (dx != 1 && jumper.jump(top.pos, -1, 0, goal, jp)) jumps[jumpCount++] = jp;
+            if (jumper.jump(top.pos, 0, 1, goal, jp)) jumps[jumpCount++] = jp;
+            if (jumper.jump(top.pos, 0, -1, goal, jp)) jumps[jumpCount++] = jp;
+        }
+        else {
+            if (jumper.jump(top.pos, 0, dy, goal, jp)) jumps[jumpCount++] = jp;
+            if (jumper.jump(top.pos, 1, 0, goal, jp)) jumps[jumpCount++] = jp;
+            if (jumper.jump(top.pos, -1, 0, goal, jp)) jumps[jumpCount++] = jp;
+        }
+
+        for (int j = 0; j < jumpCount; ++j) {
+            Point next = jumps[j];
+            int n = maze.index(next.x, next.y);
+            int tentativeG = top.g + std::abs(next.x - top.pos.x) + std::abs(next.y - top.pos.y);
+            if (buffers.isSeen(n) && buffers.gCost[n] <= tentativeG) continue;
+
+            buffers.open(n, tentativeG, top.index);
+            open.push({ tentativeG + h(next), tentativeG, n, next });
+            record.push(n, tentativeG);
+            stats.pushed++;
+        }
+    }
+
+    return false;
+}
+
+void PathFinder::prepareBidirectional(const Maze& maze, int startIndex, int goalIndex) {
+    buffers.prepare(maze.cellCount());
+    reverseBuffers.prepare(maze.cellCount());
+    exploredWidth = maze.width;
+    exploredPending = true;
+    exploredReverse = true;
+    buffers.open(startIndex, 0, -1);
+    reverseBuffers.open(goalIndex, 0, -1);
+}
+
+void PathFinder::joinBidirectionalPath(const Maze& maze, int meetForward, int meetBackward, std::vector<Point>& outPath) {
+    for (int i = meetForward; i != -1; i = buffers.parent[i]) {
+        outPath.push_back({ i % maze.width, i / maze.width });
+    }
+    std::reverse(outPath.begin(), outPath.end());
+    for (int i = meetBackward; i != -1; i = reverseBuffers.parent[i]) {
+        outPath.push_back({ i % maze.width, i / maze.width });
+    }
+}
+
+bool PathFinder::findPathBidirectionalBFS(const Maze& maze, Point start, Point goal, std::vector<Point>& outPath) {
+    int startIndex = maze.index(start.x, start.y);
+    int goalIndex = maze.index(goal.x, goal.y);
+    prepareBidirectional(maze, startIndex, goalIndex);
+
+    SearchBuffers* sides[2] = { &buffers, &reverseBuffers };
+    frontiers[0].assign(1, startIndex);
+    frontiers[1].assign(1, goalIndex);
+
+    Point directions[4] = { {0,1},{0,-1},{1,0},{-1,0} };
+    int offsets[4] = { maze.width, -maze.width, 1, -1 };
+    int best = INT_MAX, meetForward = -1, meetBackward = -1;
+
+    while (!frontiers[0].empty() && !frontiers[1].empty()) {
+        // Grow the smaller frontier by one whole level
+        int k = frontiers[0].size() <= frontiers[1].size() ? 0 : 1;
+        SearchBuffers& mine = *sides[k];
+        SearchBuffers& other = *sides[1 - k];
+        nextFrontier.clear();
+
+        for (int u : frontiers[k]) {
+            mine.close(u);
+            stats.expanded++;
+            Point p = { u % maze.width, u / maze.width };
+            for (int d = 0; d < 4; ++d) {
+                if (maze.isWall({ p.x + directions[d].x, p.y + directions[d].y })) continue;
+                int v = u + offsets[d];
+                if (other.isSeen(v) && mine.gCost[u] + 1 + other.gCost[v] < best) {
+                    best = mine.gCost[u] + 1 + other.gCost[v];
+                    meetForward = k == 0 ? u : v;
+                    meetBackward = k == 0 ? v : u;
+                }
+                if (mine.isSeen(v)) continue;
+                mine.open(v, mine.gCost[u] + 1, u);
+                nextFrontier.push_back(v);
+                stats.pushed++;
+            }
+        }
+        std::swap(frontiers[k], nextFrontier);
+
+        // Every meeting in this level has been seen, and the shortest is among them
+        if (best != INT_MAX) {
+            joinBidirectionalPath(maze, meetForward, meetBackward, outPath);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <typename Heuristic>
+bool PathFinder::findPathBidirectionalAStar(Heuristic distance, const Maze& maze, Point start, Point goal, std::vector<Point>& outPath) {
+    int startIndex = maze.index(start.x, start.y);
+    int goalIndex = maze.index(goal.x, goal.y);
+    prepareBidirectional(maze, startIndex, goalIndex);
+
+    SearchBuffers* sides[2] = { &buffers, &reverseBuffers };
+    HeapOpenList<OpenNode> forwardOpen(openHeap), backwardOpen(reverseHeap);
+    HeapOpenList<OpenNode>* open[2] = { &forwardOpen, &backwardOpen };
+    Point targets[2] = { goal, start };
+    auto h = [&](Point p, int side) { return distance(p, targets[side]); };
+
+    forwardOpen.push({ h(start, 0), 0, startIndex, start });
+    backwardOpen.push({ h(goal, 1), 0, goalIndex, goal });
+
+    Point directions[4] = { {0,1},{0,-1},{1,0},{-1,0} };
+    int offsets[4] = { maze.width, -maze.width, 1, -1 };
+    int best = INT_MAX, meetForward = -1, meetBackward = -1;
+
+    while (!forwardOpen.empty() && !backwardOpen.empty()) {
+        // Each side's lowest f bounds every path through its unexpanded nodes, so
+        // once either reaches the best meeting cost nothing cheaper is left
+        if (std::max(forwardOpen.topKey(), backwardOpen.topKey()) >= best) break;
+
+        int k = forwardOpen.size() <= backwardOpen.size() ? 0 : 1;
+        SearchBuffers& mine = *sides[k];
+        SearchBuffers& other = *sides[1 - k];
+
+        OpenNode top = open[k]->pop();
+        if (mine.isClosed(top.index) || top.g != mine.gCost[top.index]) continue;
+        mine.close(top.index);
+        stats.expanded++;
+
+        for (int d = 0; d < 4; ++d) {
+            Point neighbor = { top.pos.x + directions[d].x, top.pos.y + directions[d].y };
+            if (maze.isWall(neighbor)) continue;
+
+            int v = top.index + offsets[d];
+            int tentativeG = top.g + 1;
+            if (other.isSeen(v) && tentativeG + other.gCost[v] < best) {
+                best = tentativeG + other.gCost[v];
+                meetForward = k == 0 ? top.index : v;
+                meetBackward = k == 0 ? v : top.index;
             }
+            if (mine.isSeen(v) && mine.gCost[v] <= tentativeG) continue;
+
+            mine.open(v, tentativeG, top.index);
+            open[k]->push({ tentativeG + h(neighbor, k), tentativeG, v, neighbor });
+            stats.pushed++;
         }
     }
 
-    return {};
+    if (best == INT_MAX) return false;
+    joinBidirectionalPath(maze, meetForward, meetBackward, outPath);
+    return true;
 }
 
 bool PathFinder::isSolvable(Maze* maze) {
-    auto path = findPath(maze);
-    return !path.empty();
-}
\ No newline at end of file
+    if (!maze) return false;
+    if (maze->tracksConnectivity()) return maze->isConnected(maze->startPos, maze->endPos);
+    if (flood.run(maze->getWalkable(), maze->startPos, floodReached, FLOOD_SWEEPS, maze->endPos)) return floodReached.contains(maze->endPos);
+    if (!reachability) reachability = std::make_unique<ReachabilityEngine>();
+    return reachability->isReachable(*maze, maze->startPos, maze->endPos);
+}
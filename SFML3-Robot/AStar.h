@@ -1,22 +1,105 @@
 #pragma once
 #include "Maze.h"
+#include "CompactPath.h"
 #include "Heuristics.h"
+#include "LandmarkHeuristic.h"
 #include "Point.h"
+#include "Enums.h"
+#include "SearchBuffers.h"
+#include "BucketQueue.h"
+#include "JumpTable.h"
+#include "IncrementalPathFinder.h"
+#include "FloodFill.h"
+#include "ReachabilityEngine.h"
+#include "SearchTrace.h"
 #include <vector>
-#include <unordered_set>
 #include <queue>
 #include <unordered_map>
+#include <memory>
+
+struct SearchStats {
+    int expanded = 0;
+    int pushed = 0;
+};
 
 class PathFinder {
 private:
+    // Used by the classic search; the indexed searches are instantiated per kind instead
     std::unique_ptr<IHeuristic> heuristic;
-    std::unordered_set<Point, PointHash> explored;
+    HeuristicKind heuristicKind = HeuristicKind::MANHATTAN;
+    // Points into heuristic when it is the landmark kind; its tables follow the searched maze
+    LandmarkHeuristic* landmarks = nullptr;
+    // Indexed searches record closed cells in the buffers and only fold them in here on demand
+    mutable GridBitmap explored;
+    mutable bool exploredPending = false;
+    bool exploredReverse = false;
+    int exploredWidth = 0;
+
+    SearchMode mode = SearchMode::ASTAR;
+    SearchStats stats;
+
+    struct OpenNode { int f; int g; int index; Point pos; };
+    SearchBuffers buffers;
+    std::vector<OpenNode> openHeap;
+    // Also serves the weighted search: its open keys stay within twice the
+    // largest cell cost of each other, so the ring stays small
+    BucketQueue<OpenNode> openBuckets;
+    std::vector<Point> pathScratch;
+    // Goal-rooted half of bidirectional searches
+    SearchBuffers reverseBuffers;
+    std::vector<OpenNode> reverseHeap;
+    std::vector<int> frontiers[2];
+    std::vector<int> nextFrontier;
+    // JPS+ distances for the last maze searched in that mode, kept in sync by the maze
+    JumpTable jumpTable;
+    // LPA* state for the last maze searched in that mode; survives between calls
+    IncrementalPathFinder incremental;
+    // isSolvable tries a capped flood fill first
+    FloodFill flood;
+    GridBitmap floodReached;
+    // Created by the first isSolvable call, so finders that never check solvability own no threads
+    std::unique_ptr<ReachabilityEngine> reachability;
+    // Not owned; null means searches are instantiated without recording code
+    SearchTrace* trace = nullptr;
+
+    bool findPathClassic(const Maze& maze, Point start, Point goal, std::vector<Point>& outPath);
+    template <typename Search>
+    bool withHeuristic(Search&& search);
+    template <typename Search>
+    bool withRecorder(Search&& search);
+    template <typename OpenList, typename Jumper, typename Heuristic, typename Recorder>
+    bool findPathJump(OpenList& open, const Jumper& jumper, Heuristic distance, Recorder& record, const Maze& maze, Point start, Point goal, std::vector<Point>& outPath);
+    template <typename OpenList, typename Heuristic, typename StepCost, typename Recorder>
+    bool findPathIndexed(OpenList& open, Heuristic distance, StepCost cost, Recorder& record, const Maze& maze, Point start, Point goal, std::vector<Point>& outPath);
+    bool findPathBidirectionalBFS(const Maze& maze, Point start, Point goal, std::vector<Point>& outPath);
+    template <typename Heuristic>
+    bool findPathBidirectionalAStar(Heuristic distance, const Maze& maze, Point start, Point goal, std::vector<Point>& outPath);
+    void prepareBidirectional(const Maze& maze, int startIndex, int goalIndex);
+    void joinBidirectionalPath(const Maze& maze, int meetForward, int meetBackward, std::vector<Point>& outPath);
 
 public:
     PathFinder();
-    void clearExplored() { explored.clear(); }
-    const std::unordered_set<Point, PointHash>& getExplored() const { return explored; }
+    void clearExplored();
+    // Cells expanded by the last search; iterates in row order, count() gives the size
+    const GridBitmap& getExplored() const;
+
+    // Only WEIGHTED_ASTAR reads the maze's cell costs; every other mode counts steps
+    void setMode(SearchMode m) { mode = m; }
+    SearchMode getMode() const { return mode; }
+    void setHeuristic(HeuristicKind kind);
+    HeuristicKind getHeuristic() const { return heuristicKind; }
+    const SearchStats& getStats() const { return stats; }
+    // Records pushes and expansions of the indexed, jump point and LPA* searches
+    // into trace (not owned) until reset to null; other modes leave it empty
+    void setTrace(SearchTrace* t) { trace = t; }
+    SearchTrace* getTrace() const { return trace; }
 
     std::vector<Point> findPath(Maze* maze);
+    // Same search; only the run-length form is kept, the cell list stays in scratch
+    bool findPath(Maze* maze, CompactPath& outPath);
+    // Reuses outPath's storage; returns false when the goal is unreachable
+    bool findPath(const Maze& maze, Point start, Point goal, std::vector<Point>& outPath);
+    // Answered from the maze's union-find when it tracks connectivity, otherwise
+    // by a flood fill that hands winding mazes over to a BFS
     bool isSolvable(Maze* maze);
-};
\ No newline at end of file
+};
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Monotone integer priority queue: one bucket per key, LIFO inside a bucket.
+// Push and pop are O(1) amortised as long as keys never drop below the last
+// popped key, which holds for A* with integer edge costs and a consistent heuristic.
+// The buckets form a ring indexed by key modulo its size, which doubles when the
+// open keys spread over more than a full turn, so memory follows that spread
+// (at most a few step costs) rather than the size of the keys.
+template <typename T>
+class BucketQueue {
+private:
+    std::vector<std::vector<T>> buckets;
+    int current = 0;
+    int highest = -1;
+    size_t count = 0;
+
+    std::vector<T>& bucket(int key) { return buckets[key & static_cast<int>(buckets.size() - 1)]; }
+
+    void grow(int spread) {
+        size_t size = buckets.empty() ? 16 : buckets.size();
+        while (size <= static_cast<size_t>(spread)) size *= 2;
+        std::vector<std::vector<T>> bigger(size);
+        if (count > 0) {
+            for (int k = current; k <= highest; ++k) bigger[k & static_cast<int>(size - 1)].swap(bucket(k));
+        }
+        buckets.swap(bigger);
+    }
+
+public:
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    void push(int key, const T& value) {
+        int low = count == 0 || key < current ? key : current;
+        int high = count == 0 || key > highest ? key : highest;
+        if (static_cast<size_t>(high - low) >= buckets.size()) grow(high - low);
+        current = low;
+        highest = high;
+        bucket(key).push_back(value);
+        count++;
+    }
+
+    T pop() {
+        while (bucket(current).empty()) current++;
+        std::vector<T>& top = bucket(current);
+        T value = top.back();
+        top.pop_back();
+        count--;
+        return value;
+    }
+
+    int topKey() {
+        while (bucket(current).empty()) current++;
+        return current;
+    }
+
+    // Empties the touched buckets but keeps their storage for the next search
+    void clear() {
+        if (count > 0) {
+            for (int k = current; k <= highest; ++k) bucket(k).clear();
+        }
+        current = 0;
+        highest = -1;
+        count = 0;
+    }
+};
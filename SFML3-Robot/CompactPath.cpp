@@ -0,0 +1,84 @@
+#include "CompactPath.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+    // Indexed by the 2-bit direction of a run
+    const Point STEPS[4] = { {0,-1}, {1,0}, {0,1}, {-1,0} };
+}
+
+int CompactPath::directionOf(Point from, Point to) {
+    for (int d = 0; d < 4; ++d) {
+        if (from.x + STEPS[d].x == to.x && from.y + STEPS[d].y == to.y) return d;
+    }
+    return -1;
+}
+
+void CompactPath::clear() {
+    runs.clear();
+    cellCount = 0;
+}
+
+void CompactPath::assign(const std::vector<Point>& cells) {
+    clear();
+    for (const Point& p : cells) push_back(p);
+}
+
+void CompactPath::push_back(Point p) {
+    if (cellCount == 0) {
+        origin = last = p;
+        cellCount = 1;
+        return;
+    }
+    int d = directionOf(last, p);
+    if (d < 0) return;
+    if (!runs.empty() && runDirection(runs.back()) == d && runLength(runs.back()) < MAX_RUN) {
+        runs.back()++;
+    }
+    else {
+        runs.push_back(static_cast<std::uint16_t>((d << 14) | 1));
+    }
+    last = p;
+    cellCount++;
+}
+
+void CompactPath::reverse() {
+    std::reverse(runs.begin(), runs.end());
+    // Directions are numbered clockwise, so the opposite one differs in bit 1
+    for (std::uint16_t& run : runs) run ^= 2 << 14;
+    std::swap(origin, last);
+}
+
+CompactPath::const_iterator CompactPath::begin() const {
+    const_iterator it;
+    it.path = this;
+    it.cell = origin;
+    it.stepsLeft = runs.empty() ? 0 : runLength(runs[0]);
+    return it;
+}
+
+CompactPath::const_iterator CompactPath::end() const {
+    const_iterator it;
+    it.path = this;
+    it.cell = last;
+    it.index = cellCount;
+    it.run = runs.size();
+    return it;
+}
+
+CompactPath::const_iterator& CompactPath::const_iterator::operator++() {
+    index++;
+    if (run >= path->runs.size()) return *this;
+    Point step = STEPS[runDirection(path->runs[run])];
+    cell.x += step.x;
+    cell.y += step.y;
+    if (--stepsLeft == 0 && ++run < path->runs.size()) stepsLeft = runLength(path->runs[run]);
+    return *this;
+}
+
+std::vector<Point> CompactPath::toVector() const {
+    std::vector<Point> cells;
+    cells.reserve(cellCount);
+    for (Point p : *this) cells.push_back(p);
+    return cells;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "Point.h"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+// A 4-connected path stored as its first cell plus straight runs. Each run is
+// one 16-bit word: direction in the top 2 bits, length (1..MAX_RUN) below, so a
+// corridor of any length costs 2 bytes per turn instead of 8 bytes per cell.
+// Cells are produced on the fly by the iterator.
+class CompactPath {
+public:
+    static constexpr int MAX_RUN = 0x3FFF;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Point;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Point*;
+        using reference = const Point&;
+
+        const_iterator() = default;
+
+        reference operator*() const { return cell; }
+        pointer operator->() const { return &cell; }
+        const_iterator& operator++();
+        const_iterator operator++(int) { const_iterator old = *this; ++*this; return old; }
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+        bool operator!=(const const_iterator& other) const { return index != other.index; }
+
+        // Cells already passed, i.e. the position of this cell along the path
+        size_t position() const { return index; }
+
+    private:
+        friend class CompactPath;
+        const CompactPath* path = nullptr;
+        Point cell{ 0,0 };
+        size_t index = 0;
+        size_t run = 0;
+        int stepsLeft = 0;
+    };
+
+    CompactPath() = default;
+    explicit CompactPath(const std::vector<Point>& cells) { assign(cells); }
+
+    void clear();
+    // Consecutive cells must be 4-neighbours
+    void assign(const std::vector<Point>& cells);
+    // Starts a new path at p, or extends the current one by the neighbour p;
+    // anything else is ignored
+    void push_back(Point p);
+    // Same cells, back to front; O(runs)
+    void reverse();
+
+    bool empty() const { return cellCount == 0; }
+    size_t size() const { return cellCount; }
+    Point front() const { return origin; }
+    Point back() const { return last; }
+    size_t runCount() const { return runs.size(); }
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    std::vector<Point> toVector() const;
+    size_t memoryBytes() const { return sizeof(*this) + runs.capacity() * sizeof(std::uint16_t); }
+
+private:
+    Point origin{ 0,0 };
+    Point last{ 0,0 };
+    size_t cellCount = 0;
+    std::vector<std::uint16_t> runs;
+
+    static int directionOf(Point from, Point to);
+    static int runDirection(std::uint16_t run) { return run >> 14; }
+    static int runLength(std::uint16_t run) { return run & MAX_RUN; }
+};
@@ -0,0 +1,196 @@
+#include "Connectivity.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+    // Cells the local recheck may visit before it gives up and marks the sets dirty
+    const size_t RECHECK_BUDGET = 4096;
+}
+
+Connectivity::~Connectivity() {
+    detach();
+}
+
+void Connectivity::attach(const Maze& m) {
+    if (maze == &m) return;
+    detach();
+    maze = &m;
+    maze->addListener(this);
+    // Built straight away so edits that follow, like a generator carving, are tracked
+    rebuild();
+}
+
+void Connectivity::detach() {
+    if (maze) maze->removeListener(this);
+    maze = nullptr;
+    parent.clear();
+    dirty = true;
+}
+
+int Connectivity::find(int i) {
+    int root = i;
+    while (parent[root] >= 0) root = parent[root];
+    while (parent[i] >= 0) {
+        int next = parent[i];
+        parent[i] = root;
+        i = next;
+    }
+    return root;
+}
+
+void Connectivity::unite(int a, int b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) return;
+    // Union by size: the root's entry holds minus the component size
+    if (parent[a] > parent[b]) std::swap(a, b);
+    parent[a] += parent[b];
+    parent[b] = a;
+}
+
+void Connectivity::rebuild() {
+    const Maze& m = *maze;
+    parent.assign(m.cellCount(), -1);
+    for (int y = 0; y < m.height; ++y) {
+        for (int x = 0; x < m.width; ++x) {
+            if (m.isWall({ x, y })) continue;
+            int i = m.index(x, y);
+            if (!m.isWall({ x + 1, y })) unite(i, i + 1);
+            if (!m.isWall({ x, y + 1 })) unite(i, i + m.width);
+        }
+    }
+    dirty = false;
+    rebuilds++;
+}
+
+bool Connectivity::connected(Point a, Point b) {
+    if (!maze || maze->isWall(a) || maze->isWall(b)) return false;
+    if (dirty) rebuild();
+    return find(maze->index(a.x, a.y)) == find(maze->index(b.x, b.y));
+}
+
+// First a look at the ring around the new wall, then a breadth-first search from
+// all of its open neighbours at once, each labelled by where it started; labels
+// merge when their searches meet
+bool Connectivity::neighboursStillConnected(int x, int y) {
+    const Maze& m = *maze;
+    Point neighbours[4] = { { x, y + 1 }, { x, y - 1 }, { x + 1, y }, { x - 1, y } };
+    int open = 0;
+    for (Point n : neighbours) open += !m.isWall(n);
+    // Removing a dead end or an isolated cell cannot split anything
+    if (open <= 1) return true;
+
+    // Walk the eight cells around the wall: when every open side lies on one
+    // unbroken run of open ring cells, they still meet around a corner
+    Point ring[8] = { { x, y - 1 }, { x + 1, y - 1 }, { x + 1, y }, { x + 1, y + 1 },
+                      { x, y + 1 }, { x - 1, y + 1 }, { x - 1, y }, { x - 1, y - 1 } };
+    int firstGap = -1;
+    for (int k = 0; k < 8 && firstGap < 0; ++k) {
+        if (m.isWall(ring[k])) firstGap = k;
+    }
+    if (firstGap < 0) return true;
+    int runsWithSides = 0;
+    bool inRun = false, runHasSide = false;
+    for (int step = 1; step <= 8; ++step) {
+        int k = (firstGap + step) % 8;
+        bool wall = m.isWall(ring[k]);
+        if (!wall) {
+            inRun = true;
+            runHasSide |= (k % 2 == 0);
+        }
+        else if (inRun) {
+            runsWithSides += runHasSide;
+            inRun = runHasSide = false;
+        }
+    }
+    if (runsWithSides <= 1) return true;
+
+    if (seenStamp.size() != static_cast<size_t>(m.cellCount())) {
+        seenStamp.assign(m.cellCount(), 0);
+        seenFrom.assign(m.cellCount(), 0);
+        stamp = 0;
+    }
+    if (++stamp == 0) {
+        std::fill(seenStamp.begin(), seenStamp.end(), 0);
+        stamp = 1;
+    }
+
+    int labelRoot[4];
+    int labels = 0;
+    queue.clear();
+    for (Point n : neighbours) {
+        if (m.isWall(n)) continue;
+        int i = m.index(n.x, n.y);
+        seenStamp[i] = stamp;
+        seenFrom[i] = static_cast<std::uint8_t>(labels);
+        labelRoot[labels] = labels;
+        labels++;
+        queue.push_back(i);
+    }
+
+    auto rootOf = [&](int label) {
+        while (labelRoot[label] != label) label = labelRoot[label];
+        return label;
+    };
+    int components = labels;
+    int offsets[4] = { m.width, -m.width, 1, -1 };
+    Point directions[4] = { {0,1},{0,-1},{1,0},{-1,0} };
+    for (size_t head = 0; head < queue.size(); ++head) {
+        if (queue.size() > RECHECK_BUDGET) return false;
+        int i = queue[head];
+        Point p = { i % m.width, i / m.width };
+        int from = rootOf(seenFrom[i]);
+        for (int d = 0; d < 4; ++d) {
+            if (m.isWall({ p.x + directions[d].x, p.y + directions[d].y })) continue;
+            int n = i + offsets[d];
+            if (seenStamp[n] != stamp) {
+                seenStamp[n] = stamp;
+                seenFrom[n] = static_cast<std::uint8_t>(from);
+                queue.push_back(n);
+                continue;
+            }
+            int other = rootOf(seenFrom[n]);
+            if (other == from) continue;
+            labelRoot[other] = from;
+            if (--components == 1) return true;
+        }
+    }
+    // Some side ran out of cells: the wall really split a component
+    return false;
+}
+
+void Connectivity::onCellChanged(const Maze& m, int x, int y, CellType oldType) {
+    if (&m != maze) return;
+    bool wasWall = oldType == CellType::WALL;
+    bool isWall = m.isWall({ x, y });
+    if (wasWall == isWall) return;
+    if (dirty) return;
+
+    if (!isWall) {
+        int i = m.index(x, y);
+        // A wall that kept its set membership may be the root other cells point
+        // at, and its old component need not touch it any more
+        if (parent[i] != -1) {
+            dirty = true;
+            return;
+        }
+        Point neighbours[4] = { { x, y + 1 }, { x, y - 1 }, { x + 1, y }, { x - 1, y } };
+        for (Point n : neighbours) {
+            if (!m.isWall(n)) unite(i, m.index(n.x, n.y));
+        }
+    }
+    else if (!neighboursStillConnected(x, y)) {
+        dirty = true;
+    }
+}
+
+void Connectivity::onMazeReset(const Maze& m) {
+    if (&m == maze) dirty = true;
+}
+
+void Connectivity::onMazeDestroyed(const Maze& m) {
+    if (&m != maze) return;
+    maze = nullptr;
+    parent.clear();
+    dirty = true;
+}
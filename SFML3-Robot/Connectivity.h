@@ -0,0 +1,53 @@
+#pragma once
+#include "Maze.h"
+#include "Point.h"
+#include <cstdint>
+#include <vector>
+
+// Union-find over the open cells of a maze, kept up to date through setCell.
+// Opening a cell joins it to its open neighbours, unless the cell still belongs
+// to a set from before it was walled; that needs a rebuild. A new wall might split a
+// component, which union-find cannot undo, so a bounded search checks that its
+// open neighbours still reach each other; if that fails or runs out of budget
+// the sets are rebuilt on the next query instead.
+class Connectivity : public IMazeListener {
+public:
+    Connectivity() = default;
+    Connectivity(const Connectivity&) = delete;
+    Connectivity& operator=(const Connectivity&) = delete;
+    ~Connectivity() override;
+
+    void attach(const Maze& maze);
+    void detach();
+    const Maze* getMaze() const { return maze; }
+
+    // Both cells open and in the same component
+    bool connected(Point a, Point b);
+    bool isDirty() const { return dirty; }
+    int getRebuildCount() const { return rebuilds; }
+
+    void onCellChanged(const Maze& maze, int x, int y, CellType oldType) override;
+    void onMazeReset(const Maze& maze) override;
+    void onMazeDestroyed(const Maze& maze) override;
+
+private:
+    const Maze* maze = nullptr;
+    // Root: -(component size); otherwise the parent index. Walls added after a
+    // build stay behind as members, which is harmless while they are walls since
+    // queries check walls; only a wall that is still a singleton can be reopened
+    // in place
+    std::vector<int> parent;
+    bool dirty = true;
+    int rebuilds = 0;
+
+    // Scratch for the local recheck
+    std::vector<std::uint32_t> seenStamp;
+    std::vector<std::uint8_t> seenFrom;
+    std::uint32_t stamp = 0;
+    std::vector<int> queue;
+
+    int find(int i);
+    void unite(int a, int b);
+    void rebuild();
+    bool neighboursStillConnected(int x, int y);
+};
@@ -5,6 +5,15 @@ namespace Constants {
     constexpr float MIN_CELL_SIZE = 20.0f;
     constexpr float MAX_CELL_SIZE = 80.0f;
     constexpr float DEFAULT_ROBOT_SPEED = 0.3f;
+    // A search replay plays back over this long, whatever its event count
+    constexpr float REPLAY_SECONDS = 3.0f;
+    // Mazes above this many cells are searched on the path worker instead of in the frame
+    constexpr int SYNC_SEARCH_CELLS = 1 << 16;
+    // Unweighted mazes above this many cells are planned on the HPA* graph, and
+    // only the segment the robot is about to walk is refined into cells
+    constexpr int HIERARCHICAL_CELLS = 1 << 22;
+    // Robots F spawns to follow the shared flow field to the goal
+    constexpr int SWARM_SIZE = 50;
     constexpr int WINDOW_WIDTH = 800;
     constexpr int WINDOW_HEIGHT = 600;
     constexpr int CONTROL_PANEL_WIDTH = 200;
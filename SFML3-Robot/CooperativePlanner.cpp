@@ -0,0 +1,371 @@
+#include "CooperativePlanner.h"
+#include <algorithm>
+
+namespace {
+    // Waiting comes first, so of equally good states the search keeps the agent put
+    const Point MOVES[5] = { {0,0},{0,1},{0,-1},{1,0},{-1,0} };
+}
+
+CooperativePlanner::CooperativePlanner(int windowSteps, int replanSteps)
+    : window(std::max(1, windowSteps)), replanEvery(std::max(1, std::min(replanSteps, windowSteps))) {
+    // Routes follow terrain costs where the maze has them
+    router.setMode(SearchMode::WEIGHTED_ASTAR);
+}
+
+CooperativePlanner::~CooperativePlanner() {
+    detach();
+}
+
+void CooperativePlanner::attach(const Maze& m) {
+    detach();
+    maze = &m;
+    maze->addListener(this);
+    onMazeReset(m);
+}
+
+void CooperativePlanner::detach() {
+    if (maze) maze->removeListener(this);
+    maze = nullptr;
+    agents.clear();
+}
+
+int CooperativePlanner::addAgent(Point start, Point goal) {
+    Agent a;
+    a.cell = maze->index(start.x, start.y);
+    a.goal = maze->index(goal.x, goal.y);
+    a.routeEdits = edits - 1;
+    // A plan of one cell runs out at once, so the agent plans in the coming step
+    a.plan.push_back(a.cell);
+    a.planStart = now;
+    agents.push_back(std::move(a));
+    int id = agentCount() - 1;
+    reservePlan(id, false);
+    return id;
+}
+
+void CooperativePlanner::clearAgents() {
+    agents.clear();
+    reservations.clear();
+}
+
+Point CooperativePlanner::getPosition(int agent) const {
+    int cell = agents[agent].cell;
+    return { cell % maze->width, cell / maze->width };
+}
+
+Point CooperativePlanner::getGoal(int agent) const {
+    int cell = agents[agent].goal;
+    return { cell % maze->width, cell / maze->width };
+}
+
+int CooperativePlanner::arrivedCount() const {
+    int arrived = 0;
+    for (const Agent& a : agents) arrived += a.cell == a.goal;
+    return arrived;
+}
+
+void CooperativePlanner::step() {
+    if (!maze) return;
+    reservations.setTime(now);
+    displaced.clear();
+    for (int id = 0; id < agentCount(); ++id) {
+        const Agent& a = agents[id];
+        bool exhausted = now + 1 >= a.planStart + static_cast<int>(a.plan.size());
+        if (exhausted || (now + id) % replanEvery == 0) plan(id);
+    }
+    // Agents that lost cells to a blocked agent plan around it at once, each at
+    // most once a step so that two blocked agents cannot take turns forever.
+    // Displaced again, an agent gives up its plan and waits where it is
+    for (size_t i = 0; i < displaced.size(); ++i) {
+        Agent& a = agents[displaced[i]];
+        if (a.displacedAt == now) {
+            holdPosition(displaced[i]);
+            continue;
+        }
+        a.displacedAt = now;
+        stats.displaced++;
+        plan(displaced[i]);
+    }
+
+    resolveMoves();
+    previousCells.resize(agents.size());
+    for (size_t id = 0; id < agents.size(); ++id) {
+        previousCells[id] = agents[id].cell;
+        agents[id].cell = nextCells[id];
+    }
+    now++;
+    countConflicts();
+}
+
+void CooperativePlanner::fetchRoute(Agent& a) {
+    a.route.clear();
+    a.routeIndex = 0;
+    a.routeEdits = edits;
+    stats.routes++;
+    Point from = { a.cell % maze->width, a.cell / maze->width };
+    Point to = { a.goal % maze->width, a.goal / maze->width };
+    a.stranded = !router.findPath(*maze, from, to, routeScratch);
+    for (Point p : routeScratch) a.route.push_back(maze->index(p.x, p.y));
+}
+
+bool CooperativePlanner::followRoute(Agent& a) {
+    // Detours rejoin the route at most a window past where they left it
+    int last = std::min(static_cast<int>(a.route.size()), a.routeIndex + 2 * window + 1);
+    for (int i = a.routeIndex; i < last; ++i) {
+        if (a.route[i] == a.cell) {
+            a.routeIndex = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+int CooperativePlanner::buildRegion(int waypoint, int radius) {
+    int width = maze->width;
+    localCell.clear();
+    localDistance.clear();
+    localStamp[waypoint] = stamp;
+    localId[waypoint] = 0;
+    localCell.push_back(waypoint);
+    localDistance.push_back(0);
+    for (size_t head = 0; head < localCell.size(); ++head) {
+        int cell = localCell[head];
+        int d = localDistance[head];
+        if (d == radius) continue;
+        Point p = { cell % width, cell / width };
+        for (int m = 1; m < 5; ++m) {
+            Point next = { p.x + MOVES[m].x, p.y + MOVES[m].y };
+            if (maze->isWall(next)) continue;
+            int n = next.y * width + next.x;
+            if (localStamp[n] == stamp) continue;
+            localStamp[n] = stamp;
+            localId[n] = static_cast<int>(localCell.size());
+            localCell.push_back(n);
+            localDistance.push_back(d + 1);
+        }
+    }
+    return static_cast<int>(localCell.size());
+}
+
+void CooperativePlanner::plan(int id) {
+    Agent& a = agents[id];
+    releasePlan(id);
+    if (a.routeEdits != edits || !followRoute(a)) fetchRoute(a);
+    stats.plans++;
+
+    a.plan.assign(1, a.cell);
+    a.planStart = now;
+    if (a.stranded) {
+        reservePlan(id, false);
+        return;
+    }
+
+    if (++stamp == 0) {
+        std::fill(localStamp.begin(), localStamp.end(), 0);
+        std::fill(stateStamp.begin(), stateStamp.end(), 0);
+        stamp = 1;
+    }
+    int waypointIndex = std::min(a.routeIndex + window, static_cast<int>(a.route.size()) - 1);
+    int waypoint = a.route[waypointIndex];
+    // Whatever the agent can reach within the window lies within two windows of the waypoint
+    int regionSize = buildRegion(waypoint, 2 * window);
+    if (localStamp[a.cell] != stamp) {
+        // Only when a wall went up under the agent: it waits for the next route
+        stats.blocked++;
+        a.plan.resize(window + 1, a.cell);
+        reservePlan(id, true);
+        return;
+    }
+    int steps = window + 1;
+    size_t stateCount = static_cast<size_t>(regionSize) * steps;
+    if (stateStamp.size() < stateCount) {
+        stateStamp.resize(stateCount, 0);
+        stateParent.resize(stateCount);
+    }
+
+    int width = maze->width;
+    int startState = localId[a.cell] * steps;
+    stateStamp[startState] = stamp;
+    stateParent[startState] = -1;
+    open.clear();
+    open.push(localDistance[localId[a.cell]], startState);
+
+    // Every move, waiting included, takes one step, so a state's cost is its
+    // step and the first path to reach it is as good as any
+    int goalState = -1;
+    int bestState = startState;
+    int expanded = 0;
+    while (!open.empty() && expanded < EXPANSION_LIMIT) {
+        int s = open.pop();
+        int local = s / steps, t = s % steps;
+        int cell = localCell[local];
+        expanded++;
+        int bestT = bestState % steps;
+        if (t > bestT || (t == bestT && localDistance[local] < localDistance[bestState / steps])) bestState = s;
+
+        if (cell == waypoint) {
+            // Only a waypoint the agent can stay on for the rest of the window will do
+            bool clear = true;
+            for (int u = t + 1; u <= window && clear; ++u) clear = reservations.isFree(cell, now + u, id);
+            if (clear) {
+                goalState = s;
+                break;
+            }
+        }
+        if (t == window) continue;
+
+        Point p = { cell % width, cell / width };
+        for (int m = 0; m < 5; ++m) {
+            Point next = { p.x + MOVES[m].x, p.y + MOVES[m].y };
+            if (maze->isWall(next)) continue;
+            int n = next.y * width + next.x;
+            if (localStamp[n] != stamp) continue;
+            int ns = localId[n] * steps + t + 1;
+            if (stateStamp[ns] == stamp) continue;
+            if (!reservations.isFree(n, now + t + 1, id)) continue;
+            if (n != cell && reservations.isSwap(cell, n, now + t, id)) continue;
+            stateStamp[ns] = stamp;
+            stateParent[ns] = s;
+            open.push(t + 1 + localDistance[localId[n]], ns);
+        }
+    }
+    stats.expanded += expanded;
+
+    // Short of the waypoint, the state furthest in time and then closest to it
+    int last = goalState != -1 ? goalState : bestState;
+    bool blocked = goalState == -1 && last % steps < window;
+    if (blocked) stats.blocked++;
+    a.plan.resize(last % steps + 1);
+    for (int s = last; s != -1; s = stateParent[s]) a.plan[s % steps] = localCell[s / steps];
+    // The agent stays where the plan ends until the window is over. A blocked
+    // agent has nowhere else to be, so it takes those cells from their holders
+    a.plan.resize(steps, a.plan.back());
+    reservePlan(id, blocked);
+}
+
+void CooperativePlanner::resolveMoves() {
+    int count = agentCount();
+    nextCells.resize(count);
+    std::uint32_t mark = static_cast<std::uint32_t>(now) + 1;
+    for (int id = 0; id < count; ++id) {
+        const Agent& a = agents[id];
+        size_t k = static_cast<size_t>(now + 1 - a.planStart);
+        int next = k < a.plan.size() ? a.plan[k] : a.plan.back();
+        // Never into a cell whose reservation a blocked agent took
+        if (next != a.cell && reservations.holder(next, now + 1) != id) next = a.cell;
+        nextCells[id] = next;
+        occupantStamp[a.cell] = mark;
+        occupant[a.cell] = id;
+    }
+    for (int id = 0; id < count; ++id) {
+        int next = nextCells[id];
+        if (claimStamp[next] != mark) {
+            claimStamp[next] = mark;
+            claims[next] = 0;
+        }
+        claims[next]++;
+    }
+
+    // A move into a cell another agent moves into, into the cell of an agent
+    // that stays, or that swaps two agents becomes a wait. Waits only add
+    // agents that stay, so this settles after at most one pass per agent
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int id = 0; id < count; ++id) {
+            int cell = agents[id].cell, next = nextCells[id];
+            if (next == cell) continue;
+            bool clash = claims[next] > 1;
+            if (!clash && occupantStamp[next] == mark) {
+                int other = occupant[next];
+                clash = nextCells[other] == next || nextCells[other] == cell;
+            }
+            if (!clash) continue;
+            claims[next]--;
+            claims[cell]++;
+            nextCells[id] = cell;
+            changed = true;
+        }
+    }
+
+    for (int id = 0; id < count; ++id) {
+        const Agent& a = agents[id];
+        size_t k = static_cast<size_t>(now + 1 - a.planStart);
+        int planned = k < a.plan.size() ? a.plan[k] : a.plan.back();
+        if (nextCells[id] != planned) holdPosition(id);
+    }
+}
+
+void CooperativePlanner::holdPosition(int id) {
+    Agent& a = agents[id];
+    releasePlan(id);
+    // Runs out after this step, so the agent plans again in the next one
+    a.plan.assign(2, a.cell);
+    a.planStart = now;
+    reservePlan(id, false);
+}
+
+void CooperativePlanner::reservePlan(int id, bool force) {
+    const Agent& a = agents[id];
+    for (size_t k = 0; k < a.plan.size(); ++k) {
+        int t = a.planStart + static_cast<int>(k);
+        if (!force && !reservations.isFree(a.plan[k], t, id)) continue;
+        int previous = reservations.reserve(a.plan[k], t, id);
+        if (previous != ReservationTable::NONE && previous != id) displaced.push_back(previous);
+    }
+}
+
+void CooperativePlanner::releasePlan(int id) {
+    const Agent& a = agents[id];
+    for (size_t k = 0; k < a.plan.size(); ++k) {
+        int t = a.planStart + static_cast<int>(k);
+        if (t >= now) reservations.release(a.plan[k], t, id);
+    }
+}
+
+void CooperativePlanner::countConflicts() {
+    const std::vector<int>& previous = previousCells;
+    std::uint32_t mark = static_cast<std::uint32_t>(now);
+    for (size_t id = 0; id < agents.size(); ++id) {
+        beforeStamp[previous[id]] = mark;
+        beforeAgent[previous[id]] = static_cast<int>(id);
+    }
+    for (size_t id = 0; id < agents.size(); ++id) {
+        int cell = agents[id].cell;
+        if (afterStamp[cell] == mark) stats.conflicts++;
+        afterStamp[cell] = mark;
+        if (cell == previous[id] || beforeStamp[cell] != mark) continue;
+        // Counted by the lower id of the pair
+        int other = beforeAgent[cell];
+        if (other > static_cast<int>(id) && agents[other].cell == previous[id]) stats.conflicts++;
+    }
+}
+
+void CooperativePlanner::onCellChanged(const Maze&, int, int, CellType) {
+    // Any route may run through the cell or around it
+    edits++;
+}
+
+void CooperativePlanner::onMazeReset(const Maze& m) {
+    // Cell ids may mean something else now, so the fleet starts over
+    clearAgents();
+    now = 0;
+    edits++;
+    stats = CooperativeStats{};
+    localStamp.assign(m.cellCount(), 0);
+    localId.assign(m.cellCount(), 0);
+    beforeStamp.assign(m.cellCount(), 0);
+    afterStamp.assign(m.cellCount(), 0);
+    beforeAgent.assign(m.cellCount(), -1);
+    occupantStamp.assign(m.cellCount(), 0);
+    occupant.assign(m.cellCount(), -1);
+    claimStamp.assign(m.cellCount(), 0);
+    claims.assign(m.cellCount(), 0);
+    stamp = 0;
+    stateStamp.clear();
+}
+
+void CooperativePlanner::onMazeDestroyed(const Maze&) {
+    maze = nullptr;
+    agents.clear();
+}
@@ -0,0 +1,137 @@
+#pragma once
+#include "AStar.h"
+#include "BucketQueue.h"
+#include "Maze.h"
+#include "Point.h"
+#include "ReservationTable.h"
+#include <cstdint>
+#include <vector>
+
+struct CooperativeStats {
+    long long plans = 0;
+    long long expanded = 0;
+    // Full routes from PathFinder: one per agent, plus one whenever an agent strays off its route
+    long long routes = 0;
+    // Windows where no plan kept clear of the reservations, so the agent stood still regardless
+    long long blocked = 0;
+    // Extra plans by agents whose reservations a blocked agent took
+    long long displaced = 0;
+    // Two agents in one cell, or two agents swapping cells, after a step
+    long long conflicts = 0;
+};
+
+// Windowed cooperative A* for many agents in one maze. Every agent follows a
+// full route from PathFinder; each window it searches space-time (cell, step)
+// for the way to the route cell window steps ahead that avoids the cells and
+// swaps other agents have reserved, then reserves its own plan. An agent that
+// finds no such plan stands still and takes the cells it needs; the agents it
+// displaces plan again in the same step; displaced twice, they wait. Before
+// the fleet moves, any move into a cell the agent no longer holds, or onto or
+// across another agent, becomes a wait. Agents replan every replanEvery
+// steps, staggered by id, so each step only a slice of the fleet plans and
+// every agent's next steps are always reserved. Wall edits
+// make every agent fetch a new route at its next window.
+class CooperativePlanner : public IMazeListener {
+public:
+    static constexpr int DEFAULT_WINDOW = 16;
+
+    explicit CooperativePlanner(int window = DEFAULT_WINDOW, int replanEvery = DEFAULT_WINDOW / 2);
+    CooperativePlanner(const CooperativePlanner&) = delete;
+    CooperativePlanner& operator=(const CooperativePlanner&) = delete;
+    ~CooperativePlanner() override;
+
+    // Also removes every agent
+    void attach(const Maze& maze);
+    void detach();
+    const Maze* getMaze() const { return maze; }
+
+    // Returns the agent's id; agents are ids 0..agentCount() - 1
+    int addAgent(Point start, Point goal);
+    void clearAgents();
+    int agentCount() const { return static_cast<int>(agents.size()); }
+
+    // Plans the agents that are due, then moves every agent one step
+    void step();
+    int getTime() const { return now; }
+
+    Point getPosition(int agent) const;
+    Point getGoal(int agent) const;
+    bool atGoal(int agent) const { return agents[agent].cell == agents[agent].goal; }
+    // Agents whose goal cannot be reached from where they stand
+    bool isStranded(int agent) const { return agents[agent].stranded; }
+    int arrivedCount() const;
+    const CooperativeStats& getStats() const { return stats; }
+
+    void onCellChanged(const Maze& maze, int x, int y, CellType oldType) override;
+    void onMazeReset(const Maze& maze) override;
+    void onMazeDestroyed(const Maze& maze) override;
+
+private:
+    // Plan searches give up after this many expansions and take the best state so far
+    static constexpr int EXPANSION_LIMIT = 4096;
+
+    struct Agent {
+        int cell = 0;
+        int goal = 0;
+        // Row-major cells from where the route was fetched to the goal
+        std::vector<int> route;
+        // Position in route of the agent's cell, when it is on the route
+        int routeIndex = 0;
+        // Maze edits seen when the route was fetched
+        std::uint64_t routeEdits = 0;
+        bool stranded = false;
+        // Reserved cells for steps planStart .. planStart + plan.size() - 1
+        std::vector<int> plan;
+        int planStart = 0;
+        // Step of the last extra plan after being displaced
+        int displacedAt = -1;
+    };
+
+    const Maze* maze = nullptr;
+    int window;
+    int replanEvery;
+    int now = 0;
+    std::uint64_t edits = 0;
+    std::vector<Agent> agents;
+    ReservationTable reservations;
+    PathFinder router;
+    std::vector<Point> routeScratch;
+    CooperativeStats stats;
+    std::vector<int> displaced;
+
+    // Search scratch. Cells within reach of the window get local ids through a
+    // BFS from the waypoint, which also gives the exact distances used as the
+    // heuristic; states are local id * (window + 1) + step
+    std::vector<std::uint32_t> localStamp;
+    std::vector<int> localId;
+    std::uint32_t stamp = 0;
+    std::vector<int> localCell;
+    std::vector<int> localDistance;
+    std::vector<std::uint32_t> stateStamp;
+    std::vector<int> stateParent;
+    BucketQueue<int> open;
+
+    // Conflict checks: who stood on a cell before this step, and which cells are taken after it
+    std::vector<std::uint32_t> beforeStamp, afterStamp;
+    std::vector<int> beforeAgent;
+    std::vector<int> previousCells;
+
+    // Move resolution: where every agent goes this step, who stands on a cell
+    // before it, and how many agents end up on a cell
+    std::vector<int> nextCells;
+    std::vector<std::uint32_t> occupantStamp, claimStamp;
+    std::vector<int> occupant, claims;
+
+    void fetchRoute(Agent& a);
+    bool followRoute(Agent& a);
+    void plan(int id);
+    int buildRegion(int waypoint, int radius);
+    // force takes cells that others hold, queueing those agents in displaced
+    void reservePlan(int id, bool force);
+    void releasePlan(int id);
+    // Drops the plan and reserves the agent's cell for the next step where nobody holds it
+    void holdPosition(int id);
+    // Turns every move that would still collide into a wait
+    void resolveMoves();
+    void countConflicts();
+};
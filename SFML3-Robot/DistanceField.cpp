@@ -0,0 +1,83 @@
+#include "DistanceField.h"
+
+bool DistanceField::isCurrent(const Maze& maze, Point g) const {
+    return source == &maze && version == maze.getVersion() && goal == g;
+}
+
+bool DistanceField::update(const Maze& maze, Point g) {
+    if (isCurrent(maze, g)) return false;
+    source = &maze;
+    version = maze.getVersion();
+    goal = g;
+    build(maze);
+    return true;
+}
+
+void DistanceField::build(const Maze& maze) {
+    width = maze.width;
+    height = maze.height;
+    layout = maze.getLayout();
+    dist.assign(layout.size(), UNREACHABLE);
+    queue.clear();
+    if (maze.isWall(goal)) return;
+
+    int start = layout.index(goal.x, goal.y);
+    dist[start] = 0;
+    queue.push_back(start);
+    Point directions[4] = { {0,1},{0,-1},{1,0},{-1,0} };
+    int offsets[4];
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int i = queue[head];
+        Point p = layout.point(i);
+        layout.neighbourOffsets(p.x, p.y, offsets);
+        for (int d = 0; d < 4; ++d) {
+            if (!maze.isValid({ p.x + directions[d].x, p.y + directions[d].y })) continue;
+            int n = i + offsets[d];
+            if (maze.isWallAt(n) || dist[n] != UNREACHABLE) continue;
+            dist[n] = dist[i] + 1;
+            queue.push_back(n);
+        }
+    }
+}
+
+int DistanceField::distance(Point p) const {
+    if (p.x < 0 || p.x >= width || p.y < 0 || p.y >= height) return UNREACHABLE;
+    return dist[layout.index(p.x, p.y)];
+}
+
+bool DistanceField::nextStep(Point p, Point& next) const {
+    int d = distance(p);
+    if (d <= 0) return false;
+    Point neighbours[4] = { { p.x, p.y + 1 }, { p.x, p.y - 1 }, { p.x + 1, p.y }, { p.x - 1, p.y } };
+    for (Point n : neighbours) {
+        if (distance(n) == d - 1) {
+            next = n;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool DistanceField::pathFrom(Point p, std::vector<Point>& outPath) const {
+    outPath.clear();
+    if (distance(p) == UNREACHABLE) return false;
+    outPath.push_back(p);
+    Point next;
+    while (nextStep(p, next)) {
+        p = next;
+        outPath.push_back(p);
+    }
+    return true;
+}
+
+bool DistanceField::pathFrom(Point p, CompactPath& outPath) const {
+    outPath.clear();
+    if (distance(p) == UNREACHABLE) return false;
+    outPath.push_back(p);
+    Point next;
+    while (nextStep(p, next)) {
+        p = next;
+        outPath.push_back(p);
+    }
+    return true;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include "CompactPath.h"
+#include "GridLayout.h"
+#include "Maze.h"
+#include "Point.h"
+#include <cstdint>
+#include <vector>
+
+// BFS distances from every cell to one goal. The field remembers the maze
+// version it was built from, so update() is free until the maze or the goal
+// changes. Afterwards distance and next-step queries are O(1) from any cell.
+class DistanceField {
+public:
+    static constexpr int UNREACHABLE = -1;
+
+    // Rebuilds when the maze, its version or the goal differ; true if it did
+    bool update(const Maze& maze, Point goal);
+    bool isCurrent(const Maze& maze, Point goal) const;
+
+    // Steps to the goal, UNREACHABLE for walls, cut-off cells and outside the grid
+    int distance(Point p) const;
+    // The neighbour one step closer to the goal; false at the goal or when unreachable
+    bool nextStep(Point p, Point& next) const;
+    // Cells from p to the goal inclusive, by following nextStep
+    bool pathFrom(Point p, std::vector<Point>& outPath) const;
+    bool pathFrom(Point p, CompactPath& outPath) const;
+
+    Point getGoal() const { return goal; }
+    size_t memoryBytes() const { return (dist.capacity() + queue.capacity()) * sizeof(int); }
+
+private:
+    const Maze* source = nullptr;
+    std::uint64_t version = 0;
+    Point goal{ -1, -1 };
+    int width = 0, height = 0;
+    // The maze's storage layout; dist and queue hold its slots, not row-major ids
+    GridLayout layout;
+    std::vector<int> dist;
+    std::vector<int> queue;
+
+    void build(const Maze& maze);
+};
@@ -1,8 +1,14 @@
 #pragma once
+#include <cstdint>
 
-enum class CellType { EMPTY, WALL, START, END, SPECIAL };
-enum class GameState { IDLE, SOLVING, COMPLETE, FAILED };
+enum class CellType : std::uint8_t { EMPTY, WALL, START, END, SPECIAL };
+enum class GameState { IDLE, SEARCHING, SOLVING, COMPLETE, FAILED };
 enum class RobotState { IDLE, CALCULATING, MOVING, COMPLETED, PAUSED };
 enum class AppState { MAIN_MENU, GAME, OPTIONS };
 enum class MenuButton { START, OPTIONS, EXIT, NONE };
+enum class SearchMode { ASTAR, INDEXED_ASTAR, BUCKET_ASTAR, JPS, JPS_PLUS, BIDIRECTIONAL_BFS, BIDIRECTIONAL_ASTAR, LPA_STAR, WEIGHTED_ASTAR };
 
+enum class HeuristicKind { MANHATTAN, ZERO, OCTILE, LANDMARK };
+enum class TraceEventType { PUSH, EXPAND };
+enum class CellLayout { ROW_MAJOR, TILED };
+enum class SearchStatus { IDLE, PREPARING, RUNNING, TRACING, FOUND, NO_PATH, CANCELLED };
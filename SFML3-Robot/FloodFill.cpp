@@ -0,0 +1,109 @@
+#include "FloodFill.h"
+
+namespace {
+    // Doubles how far seeds have spread along open runs in one direction;
+    // afterwards a bit of open is set only if the next shift cells that way are
+    // open as well
+    template <int Shift>
+    void spreadUp(std::uint64_t& seeds, std::uint64_t& open) {
+        seeds |= (seeds << Shift) & open;
+        open &= open << Shift;
+    }
+    template <int Shift>
+    void spreadDown(std::uint64_t& seeds, std::uint64_t& open) {
+        seeds |= (seeds >> Shift) & open;
+        open &= open >> Shift;
+    }
+
+    // Spreads the seeds of one word along its open runs, both ways. Written out
+    // with constant shifts so that the word loops vectorise
+    std::uint64_t fillWord(std::uint64_t seeds, std::uint64_t open) {
+        std::uint64_t up = seeds, down = seeds;
+        std::uint64_t upOpen = open, downOpen = open;
+        spreadUp<1>(up, upOpen); spreadUp<2>(up, upOpen); spreadUp<4>(up, upOpen);
+        spreadUp<8>(up, upOpen); spreadUp<16>(up, upOpen); spreadUp<32>(up, upOpen);
+        spreadDown<1>(down, downOpen); spreadDown<2>(down, downOpen); spreadDown<4>(down, downOpen);
+        spreadDown<8>(down, downOpen); spreadDown<16>(down, downOpen); spreadDown<32>(down, downOpen);
+        return up | down;
+    }
+
+    const std::uint64_t TOP_BIT = std::uint64_t(1) << (GridBitmap::BITS - 1);
+
+    // Carries runs on past word boundaries, rightwards and then leftwards
+    void carryRuns(const std::uint64_t* open, std::uint64_t* reached, int words) {
+        for (int w = 1; w < words; ++w) {
+            if ((reached[w - 1] & TOP_BIT) && (open[w] & ~reached[w] & 1)) reached[w] |= fillWord(1, open[w]);
+        }
+        for (int w = words - 2; w >= 0; --w) {
+            if ((reached[w + 1] & 1) && (open[w] & ~reached[w] & TOP_BIT)) reached[w] |= fillWord(TOP_BIT, open[w]);
+        }
+    }
+}
+
+void FloodFill::markRow(int y) {
+    if (y < 0 || y >= static_cast<int>(pending.size()) || pending[y]) return;
+    pending[y] = 1;
+    pendingRows++;
+}
+
+bool FloodFill::spreadRow(const GridBitmap& open, GridBitmap& reached, int y) {
+    int words = open.getWordsPerRow();
+    const std::uint64_t* o = open.row(y);
+    const std::uint64_t* above = y > 0 ? reached.row(y - 1) : edge.data();
+    const std::uint64_t* below = y + 1 < open.getHeight() ? reached.row(y + 1) : edge.data();
+    std::uint64_t* r = reached.row(y);
+
+    // No branches, so compilers can vectorise it across the words
+    std::uint64_t gained = 0;
+    for (int w = 0; w < words; ++w) {
+        std::uint64_t seeds = (above[w] | below[w]) & o[w] & ~r[w];
+        gained |= seeds;
+        r[w] |= fillWord(seeds, o[w]);
+    }
+    if (!gained) return false;
+
+    carryRuns(o, r, words);
+    return true;
+}
+
+bool FloodFill::run(const GridBitmap& open, Point seed, GridBitmap& reached, int maxSweeps, Point stopAt) {
+    int height = open.getHeight();
+    reached.reset(open.getWidth(), height);
+    sweeps = 0;
+    if (!open.contains(seed)) return true;
+
+    int words = open.getWordsPerRow();
+    edge.assign(words, 0);
+    pending.assign(height, 0);
+    pendingRows = 0;
+    // The seed's own run, then the rows next to it
+    std::uint64_t* r = reached.row(seed.y);
+    int w = seed.x / GridBitmap::BITS;
+    r[w] = fillWord(std::uint64_t(1) << (seed.x % GridBitmap::BITS), open.row(seed.y)[w]);
+    carryRuns(open.row(seed.y), r, words);
+    markRow(seed.y - 1);
+    markRow(seed.y + 1);
+
+    bool watching = open.contains(stopAt);
+    auto step = [&](int y) {
+        if (!pending[y]) return false;
+        pending[y] = 0;
+        pendingRows--;
+        if (!spreadRow(open, reached, y)) return false;
+        markRow(y - 1);
+        markRow(y + 1);
+        return watching && y == stopAt.y && reached.test(stopAt.x, stopAt.y);
+    };
+    if (watching && reached.test(stopAt.x, stopAt.y)) return true;
+    while (pendingRows > 0) {
+        if (maxSweeps > 0 && sweeps == maxSweeps) return false;
+        sweeps++;
+        for (int y = 0; y < height; ++y) {
+            if (step(y)) return true;
+        }
+        for (int y = height - 1; y >= 0; --y) {
+            if (step(y)) return true;
+        }
+    }
+    return true;
+}
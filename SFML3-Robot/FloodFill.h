@@ -0,0 +1,34 @@
+#pragma once
+#include "GridBitmap.h"
+#include "Point.h"
+#include <cstdint>
+#include <vector>
+
+// Reachability over a bitmap of open cells, 64 cells per operation. A row
+// takes the reached cells of the rows above and below where it is open, then
+// spreads them along its open runs with shifts and masks. Sweeps go down the
+// grid and back up over the rows whose neighbours gained cells, until none
+// did. Open maps settle in a sweep or two at memory speed; every turn back
+// in a winding corridor costs another sweep, so callers can cap the sweeps
+// and fall back to a BFS.
+class FloodFill {
+public:
+    // Sets reached to the open cells connected to seed, stopping as soon as
+    // stopAt is among them. maxSweeps of 0 means no cap. True once reached is
+    // final or holds stopAt; false when the cap ran out first, leaving only
+    // part of the region in reached
+    bool run(const GridBitmap& open, Point seed, GridBitmap& reached, int maxSweeps = 0, Point stopAt = { -1, -1 });
+    int getSweeps() const { return sweeps; }
+
+private:
+    int sweeps = 0;
+    // Rows whose neighbours gained cells since they last spread
+    std::vector<char> pending;
+    int pendingRows = 0;
+    // Stands in for the rows beyond the top and bottom edges
+    std::vector<std::uint64_t> edge;
+
+    // True if the row gained cells
+    bool spreadRow(const GridBitmap& open, GridBitmap& reached, int y);
+    void markRow(int y);
+};
@@ -0,0 +1,176 @@
+#include "FlowField.h"
+#include <climits>
+
+namespace {
+    const int INF = INT_MAX;
+    const int DX[FlowField::DIRECTION_COUNT] = { 1, -1, 0, 0 };
+    const int DY[FlowField::DIRECTION_COUNT] = { 0, 0, 1, -1 };
+
+    // EAST and WEST, SOUTH and NORTH are pairs
+    std::uint8_t opposite(int d) { return static_cast<std::uint8_t>(d ^ 1); }
+}
+
+FlowField::~FlowField() {
+    detach();
+}
+
+void FlowField::attach(const Maze& m, Point g) {
+    detach();
+    maze = &m;
+    maze->addListener(this);
+    goal = g;
+    rebuild();
+}
+
+void FlowField::detach() {
+    if (maze) maze->removeListener(this);
+    maze = nullptr;
+    dist.clear();
+    dir.clear();
+}
+
+void FlowField::setGoal(Point g) {
+    goal = g;
+    if (maze) rebuild();
+}
+
+int FlowField::distance(Point p) const {
+    if (!maze || !maze->isValid(p)) return UNREACHABLE;
+    int d = dist[maze->index(p.x, p.y)];
+    return d == INF ? UNREACHABLE : d;
+}
+
+FlowField::Direction FlowField::direction(Point p) const {
+    if (!maze || !maze->isValid(p)) return DIRECTION_COUNT;
+    return static_cast<Direction>(dir[maze->index(p.x, p.y)]);
+}
+
+bool FlowField::nextStep(Point p, Point& next) const {
+    Direction d = direction(p);
+    if (d == DIRECTION_COUNT) return false;
+    next = { p.x + DX[d], p.y + DY[d] };
+    return true;
+}
+
+void FlowField::rebuild() {
+    const Maze& m = *maze;
+    dist.assign(m.cellCount(), INF);
+    dir.assign(m.cellCount(), DIRECTION_COUNT);
+    lastUpdate = 0;
+    if (m.isWall(goal)) return;
+
+    int g = m.index(goal.x, goal.y);
+    dist[g] = 0;
+    if (m.isWeighted()) {
+        open.clear();
+        open.push(0, g);
+        propagate();
+        return;
+    }
+    // Unit steps: first reached is final, so a FIFO queue does
+    cells.assign(1, g);
+    for (size_t head = 0; head < cells.size(); ++head) {
+        int u = cells[head];
+        int x = u % m.width, y = u / m.width;
+        for (int d = 0; d < DIRECTION_COUNT; ++d) {
+            Point q = { x + DX[d], y + DY[d] };
+            if (m.isWall(q)) continue;
+            int v = u + DY[d] * m.width + DX[d];
+            if (dist[v] != INF) continue;
+            dist[v] = dist[u] + 1;
+            dir[v] = opposite(d);
+            cells.push_back(v);
+        }
+    }
+    lastUpdate = cells.size();
+}
+
+void FlowField::propagate() {
+    const Maze& m = *maze;
+    while (!open.empty()) {
+        int key = open.topKey();
+        int u = open.pop();
+        // Superseded by a cheaper push of the same cell
+        if (key != dist[u]) continue;
+        lastUpdate++;
+        // Whoever steps onto u pays u's cost
+        int through = key + m.moveCost(u);
+        int x = u % m.width, y = u / m.width;
+        for (int d = 0; d < DIRECTION_COUNT; ++d) {
+            Point q = { x + DX[d], y + DY[d] };
+            if (m.isWall(q)) continue;
+            int v = u + DY[d] * m.width + DX[d];
+            if (through >= dist[v]) continue;
+            dist[v] = through;
+            dir[v] = opposite(d);
+            open.push(through, v);
+        }
+    }
+}
+
+void FlowField::repair(int x, int y) {
+    const Maze& m = *maze;
+    lastUpdate = 0;
+    // Cut off the changed cell and every cell whose way to the goal ran through
+    // it, found by following the directions backwards
+    int c = m.index(x, y);
+    dist[c] = INF;
+    dir[c] = DIRECTION_COUNT;
+    cells.assign(1, c);
+    for (size_t i = 0; i < cells.size(); ++i) {
+        int u = cells[i];
+        int ux = u % m.width, uy = u / m.width;
+        for (int d = 0; d < DIRECTION_COUNT; ++d) {
+            if (!m.isValid({ ux + DX[d], uy + DY[d] })) continue;
+            int v = u + DY[d] * m.width + DX[d];
+            if (dir[v] != opposite(d)) continue;
+            dist[v] = INF;
+            dir[v] = DIRECTION_COUNT;
+            cells.push_back(v);
+        }
+    }
+
+    // Each cut-off cell restarts from its best neighbour outside the cut; the
+    // search then settles the cut and lowers any cell that now does better
+    open.clear();
+    int g = m.isWall(goal) ? -1 : m.index(goal.x, goal.y);
+    for (int u : cells) {
+        if (u == g) {
+            dist[u] = 0;
+            open.push(0, u);
+            continue;
+        }
+        int ux = u % m.width, uy = u / m.width;
+        if (m.isWall({ ux, uy })) continue;
+        int best = INF, bestDir = DIRECTION_COUNT;
+        for (int d = 0; d < DIRECTION_COUNT; ++d) {
+            Point q = { ux + DX[d], uy + DY[d] };
+            if (m.isWall(q)) continue;
+            int v = u + DY[d] * m.width + DX[d];
+            if (dist[v] == INF || dist[v] + m.moveCost(v) >= best) continue;
+            best = dist[v] + m.moveCost(v);
+            bestDir = d;
+        }
+        if (best == INF) continue;
+        dist[u] = best;
+        dir[u] = static_cast<std::uint8_t>(bestDir);
+        open.push(best, u);
+    }
+    propagate();
+}
+
+void FlowField::onCellChanged(const Maze& m, int x, int y, CellType) {
+    // A wall going up or down and a new step cost are repaired alike
+    if (&m == maze) repair(x, y);
+}
+
+void FlowField::onMazeReset(const Maze& m) {
+    if (&m == maze) rebuild();
+}
+
+void FlowField::onMazeDestroyed(const Maze& m) {
+    if (&m != maze) return;
+    maze = nullptr;
+    dist.clear();
+    dir.clear();
+}
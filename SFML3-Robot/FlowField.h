@@ -0,0 +1,60 @@
+#pragma once
+#include "Maze.h"
+#include "Point.h"
+#include "RadixHeap.h"
+#include <cstdint>
+#include <vector>
+
+// Shared next steps towards one goal for any number of robots. One pass out
+// from the goal leaves every cell its cost to the goal and the direction of
+// the neighbour that cost comes through, so each robot reads its next step in
+// O(1). Costs follow the maze's step costs; on a maze without terrain the
+// pass is a plain BFS. The field listens to its maze and on setCell repairs
+// only the cells whose way to the goal ran through the changed cell, plus
+// those that can now do better through it.
+class FlowField : public IMazeListener {
+public:
+    enum Direction : std::uint8_t { EAST, WEST, SOUTH, NORTH, DIRECTION_COUNT };
+    static constexpr int UNREACHABLE = -1;
+
+    FlowField() = default;
+    FlowField(const FlowField&) = delete;
+    FlowField& operator=(const FlowField&) = delete;
+    ~FlowField() override;
+
+    void attach(const Maze& maze, Point goal);
+    void detach();
+    const Maze* getMaze() const { return maze; }
+    // Rebuilds the whole field
+    void setGoal(Point goal);
+    Point getGoal() const { return goal; }
+
+    // Cost to the goal, UNREACHABLE for walls, cut-off cells and outside the grid
+    int distance(Point p) const;
+    // DIRECTION_COUNT at the goal and wherever the goal is out of reach
+    Direction direction(Point p) const;
+    bool nextStep(Point p, Point& next) const;
+
+    // Cells settled by the last rebuild or repair
+    size_t getLastUpdateCells() const { return lastUpdate; }
+    size_t memoryBytes() const { return dist.capacity() * sizeof(int) + dir.capacity(); }
+
+    void onCellChanged(const Maze& maze, int x, int y, CellType oldType) override;
+    void onMazeReset(const Maze& maze) override;
+    void onMazeDestroyed(const Maze& maze) override;
+
+private:
+    const Maze* maze = nullptr;
+    Point goal{ -1, -1 };
+    // Row-major like Maze::index; unreached cells hold INF and DIRECTION_COUNT
+    std::vector<int> dist;
+    std::vector<std::uint8_t> dir;
+    RadixHeap<int> open;
+    // BFS queue, or the cells a repair cut off
+    std::vector<int> cells;
+    size_t lastUpdate = 0;
+
+    void rebuild();
+    void repair(int x, int y);
+    void propagate();
+};
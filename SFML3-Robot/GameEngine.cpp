@@ -1,11 +1,17 @@
 #include "GameEngine.h"
 #include "SimpleJSON.h"
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <iostream>
+#include <random>
+#include <sstream>
 #include <string>
 
 GameEngine::GameEngine() : playerRobot(std::make_unique<Robot>()),
 pathFinder(std::make_unique<PathFinder>()) {
+    pathFinder->setMode(SearchMode::BUCKET_ASTAR);
+    pathFinder->setTrace(&searchTrace);
 
     // Try to load font from common locations
     std::vector<std::string> fontPaths = {
@@ -116,6 +122,7 @@ void GameEngine::loadLevel() {
     };
 
     currentMaze = std::make_unique<Maze>(10, 9);
+    currentMaze->enableConnectivity();
     currentMaze->loadFromMap(levelMap);
     playerRobot->setPosition(currentMaze->startPos);
     state = GameState::IDLE;
@@ -151,22 +158,139 @@ void GameEngine::updateMazePosition() {
     }
 }
 
-void GameEngine::computePath() {
+void GameEngine::computePath(bool edited) {
     if (!currentMaze) return;
+    replaying = false;
+    hierarchicalPath = false;
+    if (currentMaze->cellCount() > Constants::SYNC_SEARCH_CELLS) {
+        playerRobot->setPosition(currentMaze->startPos);
+        if (usesHierarchy()) planHierarchical(currentMaze->startPos);
+        else beginBackgroundSearch(currentMaze->startPos);
+        return;
+    }
+    backgroundSearch = false;
+    pathWorker.cancel();
     pathFinder->clearExplored();
-    solutionPath = pathFinder->findPath(currentMaze.get());
-    if (solutionPath.empty()) {
+    // LPA* is several times slower than bucket A* on a search from scratch and
+    // only pays off repairing its previous search after a wall edit. Both count
+    // steps, so terrain costs need the weighted search
+    SearchMode mode = edited ? SearchMode::LPA_STAR : SearchMode::BUCKET_ASTAR;
+    pathFinder->setMode(currentMaze->isWeighted() ? SearchMode::WEIGHTED_ASTAR : mode);
+    if (!pathFinder->findPath(currentMaze.get(), solutionPath)) {
         std::cout << "No path found!" << std::endl;
         state = GameState::FAILED;
     }
     else {
         state = GameState::SOLVING;
-        pathIndex = 0;
-        if (!solutionPath.empty() && solutionPath[0] == currentMaze->startPos) pathIndex = 1;
+        pathCursor = solutionPath.begin();
+        if (solutionPath.front() == currentMaze->startPos) ++pathCursor;
         playerRobot->setPosition(currentMaze->startPos);
     }
 }
 
+void GameEngine::replanFrom(Point cell) {
+    if (!currentMaze) return;
+    replaying = false;
+    hierarchicalPath = false;
+    if (currentMaze->cellCount() > Constants::SYNC_SEARCH_CELLS) {
+        if (usesHierarchy()) planHierarchical(cell);
+        else beginBackgroundSearch(cell);
+        return;
+    }
+    backgroundSearch = false;
+    pathWorker.cancel();
+    pathFinder->clearExplored();
+    bool found;
+    if (currentMaze->isWeighted()) {
+        // The distance field counts steps as well
+        std::vector<Point> cells;
+        pathFinder->setMode(SearchMode::WEIGHTED_ASTAR);
+        found = pathFinder->findPath(*currentMaze, cell, currentMaze->endPos, cells);
+        solutionPath.assign(cells);
+    }
+    else {
+        // The distance field records nothing to replay
+        searchTrace.begin(currentMaze->width, currentMaze->height);
+        goalField.update(*currentMaze, currentMaze->endPos);
+        found = goalField.pathFrom(cell, solutionPath);
+    }
+    if (!found) {
+        std::cout << "No path found!" << std::endl;
+        state = GameState::FAILED;
+        return;
+    }
+    state = GameState::SOLVING;
+    pathCursor = solutionPath.begin();
+    ++pathCursor;
+}
+
+void GameEngine::beginBackgroundSearch(Point from) {
+    backgroundSearch = true;
+    pathFinder->clearExplored();
+    backgroundExplored.reset(0, 0);
+    // Nothing to replay from a background search
+    searchTrace.begin(currentMaze->width, currentMaze->height);
+    solutionPath.clear();
+    pathCursor = solutionPath.end();
+    // Supersedes and cancels whatever the worker was still doing
+    pathWorker.submit(*currentMaze, from, currentMaze->endPos);
+    state = GameState::SEARCHING;
+}
+
+void GameEngine::finishBackgroundSearch(PathJobResult& result) {
+    backgroundExplored = std::move(result.explored);
+    if (result.status != SearchStatus::FOUND) {
+        std::cout << "No path found!" << std::endl;
+        state = GameState::FAILED;
+        return;
+    }
+    solutionPath = std::move(result.path);
+    state = GameState::SOLVING;
+    pathCursor = solutionPath.begin();
+    if (solutionPath.front() == playerRobot->getPosition()) ++pathCursor;
+}
+
+bool GameEngine::usesHierarchy() const {
+    // The abstract graph counts steps, so terrain costs stay with the worker
+    return currentMaze->cellCount() > Constants::HIERARCHICAL_CELLS && !currentMaze->isWeighted();
+}
+
+void GameEngine::planHierarchical(Point from) {
+    backgroundSearch = false;
+    pathWorker.cancel();
+    pathFinder->clearExplored();
+    // The abstract search visits entrances, not cells: nothing to replay
+    searchTrace.begin(currentMaze->width, currentMaze->height);
+    solutionPath.clear();
+    pathCursor = solutionPath.end();
+    // Scans the borders once per maze; cluster distances follow as queries need them
+    hierarchy.attach(*currentMaze);
+    if (!hierarchy.planAbstract(from, currentMaze->endPos)) {
+        std::cout << "No path found!" << std::endl;
+        state = GameState::FAILED;
+        return;
+    }
+    hierarchicalPath = true;
+    nextSegment = 0;
+    state = GameState::SOLVING;
+    solutionPath.push_back(from);
+    pathCursor = solutionPath.end();
+    if (hierarchy.getAbstractPath().size() > 1 && !refineNextSegment()) {
+        std::cout << "No path found!" << std::endl;
+        state = GameState::FAILED;
+    }
+}
+
+bool GameEngine::refineNextSegment() {
+    std::vector<Point> cells{ hierarchy.getAbstractPath()[nextSegment] };
+    if (!hierarchy.refineSegment(nextSegment, cells)) return false;
+    nextSegment++;
+    solutionPath.assign(cells);
+    pathCursor = solutionPath.begin();
+    ++pathCursor;
+    return true;
+}
+
 void GameEngine::zoomIn() {
     CELL_SIZE = std::min(Constants::MAX_CELL_SIZE, CELL_SIZE + 5.0f);
     updateMazePosition();
@@ -188,6 +312,8 @@ void GameEngine::generateMaze() {
         height = std::max(5, std::min(30, height));
 
         currentMaze = std::make_unique<Maze>(width, height);
+        // Tracked while carving, so the Tester button answers from the union-find
+        currentMaze->enableConnectivity();
         currentMaze->generateSolvableMaze();
         playerRobot->setPosition(currentMaze->startPos);
         state = GameState::IDLE;
@@ -216,8 +342,19 @@ void GameEngine::toggleRunPause() {
         if (state == GameState::COMPLETE || state == GameState::FAILED) {
             // Reset if completed or failed
             playerRobot->setPosition(currentMaze->startPos);
-            pathIndex = 1;
-            state = GameState::SOLVING;
+            if (hierarchicalPath) {
+                // Only the last segment is left to walk again
+                planHierarchical(currentMaze->startPos);
+            }
+            else if (solutionPath.empty() || solutionPath.front() != currentMaze->startPos) {
+                // A replan after an edit starts where the robot stood, not at the start
+                computePath();
+            }
+            else {
+                pathCursor = solutionPath.begin();
+                if (pathCursor != solutionPath.end()) ++pathCursor;
+                state = GameState::SOLVING;
+            }
         }
         playerRobot->resume();
         isRunning = true;
@@ -238,7 +375,10 @@ void GameEngine::saveMaze() {
     std::ofstream file(filename);
     if (file.is_open()) {
         auto mazeLayout = currentMaze->toStringVector();
-        std::string json = SimpleJSON::stringify(mazeLayout, currentMazeName, currentMaze->width, currentMaze->height);
+        // SPECIAL cells already show as '~'; the cost table is only needed once some cell costs more than 1
+        std::vector<std::uint8_t> costs;
+        if (currentMaze->isWeighted()) costs = currentMaze->getCosts();
+        std::string json = SimpleJSON::stringify(mazeLayout, currentMazeName, currentMaze->width, currentMaze->height, costs);
         file << json;
         file.close();
         std::cout << "Maze saved as: " << filename << std::endl;
@@ -248,6 +388,62 @@ void GameEngine::saveMaze() {
     }
 }
 
+void GameEngine::loadMaze() {
+    std::string filename = currentMazeName + ".json";
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cout << "Could not open: " << filename << std::endl;
+        return;
+    }
+    std::stringstream text;
+    text << file.rdbuf();
+
+    std::vector<std::string> mazeLayout;
+    std::vector<std::uint8_t> costs;
+    std::string name = currentMazeName;
+    if (!SimpleJSON::parse(text.str(), mazeLayout, name, costs)) {
+        std::cout << "Invalid maze file: " << filename << std::endl;
+        return;
+    }
+
+    currentMaze = std::make_unique<Maze>();
+    currentMaze->enableConnectivity();
+    currentMaze->loadFromMap(mazeLayout);
+    if (!costs.empty()) currentMaze->setCosts(costs);
+    playerRobot->setPosition(currentMaze->startPos);
+    state = GameState::IDLE;
+    isRunning = false;
+    computePath();
+    updateMazePosition();
+
+    std::cout << "Maze loaded: " << name << std::endl;
+}
+
+void GameEngine::toggleCellAt(sf::Vector2f mousePos, CellType type) {
+    if (!currentMaze) return;
+
+    int x = static_cast<int>(std::floor((mousePos.x - mazeOffset.x) / CELL_SIZE));
+    int y = static_cast<int>(std::floor((mousePos.y - mazeOffset.y) / CELL_SIZE));
+    if (!currentMaze->isValid({ x, y })) return;
+
+    CellType t = currentMaze->getCell(x, y);
+    if (t == CellType::START || t == CellType::END) return;
+    currentMaze->setCell(x, y, t == type ? CellType::EMPTY : type);
+    isRunning = false;
+    gameButtons[3].setText("Run", font);
+
+    // A robot that has already set off carries on from its cell instead of starting over
+    Point robotCell = playerRobot->getPosition();
+    bool underway = state == GameState::SOLVING || state == GameState::SEARCHING;
+    if (underway && robotCell != currentMaze->startPos) {
+        playerRobot->setPosition(robotCell);
+        replanFrom(robotCell);
+    }
+    else {
+        computePath(true);
+    }
+}
+
 void GameEngine::resizeMaze() {
     if (!currentMaze) return;
 
@@ -478,6 +674,16 @@ void GameEngine::handleGameEvents(sf::Event& event, sf::RenderWindow& window) {
         }
     }
 
+    if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Right) {
+        toggleCellAt(sf::Vector2f(static_cast<float>(event.mouseButton.x),
+            static_cast<float>(event.mouseButton.y)), CellType::WALL);
+    }
+
+    if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Middle) {
+        toggleCellAt(sf::Vector2f(static_cast<float>(event.mouseButton.x),
+            static_cast<float>(event.mouseButton.y)), CellType::SPECIAL);
+    }
+
     if (event.type == sf::Event::TextEntered) {
         mazeNameInput->handleTextEntered(event.text.unicode);
         mazeWidthInput->handleTextEntered(event.text.unicode);
@@ -494,20 +700,116 @@ void GameEngine::handleGameEvents(sf::Event& event, sf::RenderWindow& window) {
         if (event.key.code == sf::Keyboard::R) {
             loadLevel();
         }
+        // Not while the name is being typed, since it may well contain an L
+        if (event.key.code == sf::Keyboard::L && !mazeNameInput->isFocused()) {
+            loadMaze();
+        }
+        if (event.key.code == sf::Keyboard::F && !mazeNameInput->isFocused()) {
+            toggleSwarm();
+        }
+        if (event.key.code == sf::Keyboard::V && !mazeNameInput->isFocused()) {
+            showReachable = !showReachable;
+        }
+        if (event.key.code == sf::Keyboard::T && !mazeNameInput->isFocused()) {
+            toggleReplay();
+        }
+        if (replaying && (event.key.code == sf::Keyboard::Left || event.key.code == sf::Keyboard::Right)) {
+            // Scrub by a twentieth of the search
+            size_t step = std::max<size_t>(1, searchTrace.size() / 20);
+            if (event.key.code == sf::Keyboard::Right) seekReplay(replayCursor + step);
+            else seekReplay(replayCursor > step ? replayCursor - step : 0);
+            replayEvents = static_cast<float>(replayCursor);
+        }
         if (event.key.code == sf::Keyboard::Escape) {
             appState = AppState::MAIN_MENU;
         }
     }
 }
 
+void GameEngine::toggleSwarm() {
+    if (!currentMaze) return;
+    if (!swarm.empty()) {
+        swarm.clear();
+        swarmField.detach();
+        return;
+    }
+
+    swarmField.attach(*currentMaze, currentMaze->endPos);
+    std::vector<Point> cells;
+    for (int y = 0; y < currentMaze->height; ++y) {
+        for (int x = 0; x < currentMaze->width; ++x) {
+            Point p = { x, y };
+            if (p != currentMaze->endPos && swarmField.distance(p) != FlowField::UNREACHABLE) cells.push_back(p);
+        }
+    }
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::shuffle(cells.begin(), cells.end(), gen);
+    cells.resize(std::min<size_t>(cells.size(), Constants::SWARM_SIZE));
+    for (Point p : cells) {
+        Robot robot;
+        robot.setPosition(p);
+        robot.setMoveDuration(robotSpeed);
+        swarm.push_back(robot);
+    }
+}
+
+void GameEngine::toggleReplay() {
+    if (replaying || searchTrace.empty()) {
+        replaying = false;
+        return;
+    }
+    replaying = true;
+    replayEvents = 0.0f;
+    seekReplay(0);
+}
+
+void GameEngine::seekReplay(size_t target) {
+    target = std::min(target, searchTrace.size());
+    if (target < replayCursor || replayExpanded.getWidth() != searchTrace.getWidth()) {
+        replayExpanded.reset(searchTrace.getWidth(), searchTrace.getHeight());
+        replayFrontier.reset(searchTrace.getWidth(), searchTrace.getHeight());
+        replayCursor = 0;
+    }
+    int width = searchTrace.getWidth();
+    for (; replayCursor < target; ++replayCursor) {
+        const TraceEvent& e = searchTrace[replayCursor];
+        int x = e.cell() % width, y = e.cell() / width;
+        bool expanded = e.type() == TraceEventType::EXPAND;
+        replayFrontier.set(x, y, !expanded);
+        if (expanded) replayExpanded.set(x, y, true);
+    }
+}
+
 void GameEngine::updateGame(float dt) {
-    if (isRunning && state == GameState::SOLVING && !playerRobot->isMoving() && pathIndex < solutionPath.size()) {
-        playerRobot->moveTo(solutionPath[pathIndex]);
-        pathIndex++;
+    if (state == GameState::SEARCHING) {
+        if (std::unique_ptr<PathJobResult> result = pathWorker.poll()) finishBackgroundSearch(*result);
+    }
+    if (replaying) {
+        replayEvents += dt * static_cast<float>(searchTrace.size()) / Constants::REPLAY_SECONDS;
+        seekReplay(static_cast<size_t>(replayEvents));
+        // The last frame of a replay is the ordinary explored overlay
+        if (replayCursor == searchTrace.size()) replaying = false;
+    }
+
+    if (isRunning && state == GameState::SOLVING) {
+        bool segmentDone = hierarchicalPath && pathCursor == solutionPath.end();
+        if (segmentDone && nextSegment + 1 < hierarchy.getAbstractPath().size() && !refineNextSegment()) {
+            std::cout << "No path found!" << std::endl;
+            state = GameState::FAILED;
+        }
+        playerRobot->advance(pathCursor, solutionPath.end());
     }
 
     playerRobot->update(dt);
 
+    // The field lets go of a maze that is replaced, and the swarm goes with it
+    if (!swarm.empty() && swarmField.getMaze() != currentMaze.get()) swarm.clear();
+    for (Robot& robot : swarm) {
+        robot.advance(swarmField);
+        robot.update(dt);
+    }
+
     if (state == GameState::SOLVING && playerRobot->getPosition() == currentMaze->endPos) {
         state = GameState::COMPLETE;
         playerRobot->setState(RobotState::COMPLETED);
@@ -575,14 +877,26 @@ void GameEngine::drawGame(sf::RenderWindow& window) {
     mazeWidthInput->draw(window);
     mazeHeightInput->draw(window);
 
+    if (state == GameState::SEARCHING && fontLoaded) {
+        int percent = static_cast<int>(pathWorker.getProgress() * 100.0f);
+        sf::Text progress("Searching... " + std::to_string(percent) + "%", font, 16);
+        progress.setFillColor(sf::Color::White);
+        progress.setPosition(610, 560);
+        window.draw(progress);
+    }
+
     // Draw maze centered
     drawMaze(window);
+    if (showReachable) {
+        drawReachable(window);
+    }
     if (showPath) {
         drawPathOverlay(window);
     }
     if (showExploredCells) {
         drawExploredCells(window);
     }
+    drawSwarm(window);
     drawRobot(window);
 }
 
@@ -592,13 +906,14 @@ void GameEngine::drawMaze(sf::RenderWindow& window) {
     sf::RectangleShape cellShape(sf::Vector2f(CELL_SIZE - 2.0f, CELL_SIZE - 2.0f));
     for (int y = 0; y < currentMaze->height; ++y) {
         for (int x = 0; x < currentMaze->width; ++x) {
-            CellType t = currentMaze->grid[y][x]->getType();
+            CellType t = currentMaze->getCell(x, y);
             cellShape.setPosition(x * CELL_SIZE + mazeOffset.x + 1.0f,
                 y * CELL_SIZE + mazeOffset.y + 1.0f);
             switch (t) {
             case CellType::WALL: cellShape.setFillColor(sf::Color::Black); break;
             case CellType::START: cellShape.setFillColor(sf::Color(100, 220, 100)); break;
             case CellType::END: cellShape.setFillColor(sf::Color(220, 100, 100)); break;
+            case CellType::SPECIAL: cellShape.setFillColor(sf::Color(190, 160, 100)); break;
             default: cellShape.setFillColor(sf::Color(200, 200, 200)); break;
             }
             window.draw(cellShape);
@@ -610,14 +925,23 @@ void GameEngine::drawExploredCells(sf::RenderWindow& window) {
     if (!currentMaze) return;
 
     sf::RectangleShape exploredShape(sf::Vector2f(CELL_SIZE - 6.0f, CELL_SIZE - 6.0f));
-    exploredShape.setFillColor(sf::Color(180, 180, 180, 160));
-    for (const Point& p : pathFinder->getExplored()) {
-        CellType t = currentMaze->grid[p.y][p.x]->getType();
-        if (t == CellType::WALL || t == CellType::START || t == CellType::END) continue;
-        exploredShape.setPosition(p.x * CELL_SIZE + mazeOffset.x + 3.0f,
-            p.y * CELL_SIZE + mazeOffset.y + 3.0f);
-        window.draw(exploredShape);
+    auto drawCells = [&](const GridBitmap& cells, sf::Color color) {
+        exploredShape.setFillColor(color);
+        for (Point p : cells) {
+            if (!currentMaze->isValid(p)) continue;
+            CellType t = currentMaze->getCell(p.x, p.y);
+            if (t == CellType::WALL || t == CellType::START || t == CellType::END) continue;
+            exploredShape.setPosition(p.x * CELL_SIZE + mazeOffset.x + 3.0f,
+                p.y * CELL_SIZE + mazeOffset.y + 3.0f);
+            window.draw(exploredShape);
+        }
+    };
+    if (replaying) {
+        drawCells(replayExpanded, sf::Color(180, 180, 180, 160));
+        drawCells(replayFrontier, sf::Color(120, 170, 230, 160));
+        return;
     }
+    drawCells(backgroundSearch ? backgroundExplored : pathFinder->getExplored(), sf::Color(180, 180, 180, 160));
 }
 
 void GameEngine::drawPathOverlay(sf::RenderWindow& window) {
@@ -626,7 +950,7 @@ void GameEngine::drawPathOverlay(sf::RenderWindow& window) {
     sf::RectangleShape pathShape(sf::Vector2f(CELL_SIZE - 8.0f, CELL_SIZE - 8.0f));
     pathShape.setFillColor(sf::Color(220, 220, 100, 200));
     for (const Point& p : solutionPath) {
-        CellType t = currentMaze->grid[p.y][p.x]->getType();
+        CellType t = currentMaze->getCell(p.x, p.y);
         if (t == CellType::WALL) continue;
         pathShape.setPosition(p.x * CELL_SIZE + mazeOffset.x + 4.0f,
             p.y * CELL_SIZE + mazeOffset.y + 4.0f);
@@ -648,4 +972,34 @@ void GameEngine::drawRobot(sf::RenderWindow& window) {
     float centerY = floatPos.y + mazeOffset.y + (CELL_SIZE / 2.0f - robotShape.getRadius());
     robotShape.setPosition(centerX, centerY);
     window.draw(robotShape);
+}
+
+void GameEngine::drawSwarm(sf::RenderWindow& window) {
+    if (!currentMaze || swarm.empty()) return;
+
+    float radius = CELL_SIZE / 5.0f;
+    sf::CircleShape robotShape(radius);
+    robotShape.setFillColor(sf::Color(240, 150, 40));
+    for (const Robot& robot : swarm) {
+        sf::Vector2f floatPos = robot.getFloatPos(CELL_SIZE);
+        robotShape.setPosition(floatPos.x + mazeOffset.x + CELL_SIZE / 2.0f - radius,
+            floatPos.y + mazeOffset.y + CELL_SIZE / 2.0f - radius);
+        window.draw(robotShape);
+    }
+}
+
+void GameEngine::drawReachable(sf::RenderWindow& window) {
+    if (!currentMaze) return;
+
+    if (reachableVersion != currentMaze->getVersion()) {
+        flood.run(currentMaze->getWalkable(), currentMaze->startPos, reachableCells);
+        reachableVersion = currentMaze->getVersion();
+    }
+    sf::RectangleShape reachableShape(sf::Vector2f(CELL_SIZE - 2.0f, CELL_SIZE - 2.0f));
+    reachableShape.setFillColor(sf::Color(100, 200, 120, 90));
+    for (Point p : reachableCells) {
+        reachableShape.setPosition(p.x * CELL_SIZE + mazeOffset.x + 1.0f,
+            p.y * CELL_SIZE + mazeOffset.y + 1.0f);
+        window.draw(reachableShape);
+    }
 }
\ No newline at end of file
@@ -3,6 +3,13 @@
 #include "Robot.h"
 #include "Enums.h"
 #include "AStar.h"
+#include "CompactPath.h"
+#include "DistanceField.h"
+#include "FloodFill.h"
+#include "FlowField.h"
+#include "HierarchicalPathFinder.h"
+#include "PathWorker.h"
+#include "SearchTrace.h"
 #include "Button.h"
 #include "Slider.h"
 #include "TextInput.h"
@@ -20,8 +27,40 @@ private:
     AppState appState = AppState::MAIN_MENU;
 
     float CELL_SIZE = Constants::DEFAULT_CELL_SIZE;
-    std::vector<Point> solutionPath;
-    size_t pathIndex = 0;
+    CompactPath solutionPath;
+    // Distances to endPos; rebuilt lazily when the maze version changes
+    DistanceField goalField;
+    // Next cell the robot will move to
+    CompactPath::const_iterator pathCursor;
+
+    // Large mazes are searched on a snapshot in the background while the state is SEARCHING
+    PathWorker pathWorker;
+    bool backgroundSearch = false;
+    GridBitmap backgroundExplored;
+
+    // Huge unweighted mazes walk a plan on this graph; solutionPath then holds
+    // the current segment only and nextSegment is the one refined after it
+    HierarchicalPathFinder hierarchy;
+    bool hierarchicalPath = false;
+    size_t nextSegment = 0;
+
+    // V shades the cells reachable from startPos; refilled when the maze version changes
+    FloodFill flood;
+    GridBitmap reachableCells;
+    std::uint64_t reachableVersion = 0;
+    bool showReachable = false;
+
+    // F scatters robots over the maze that all read their steps from one flow field to endPos
+    FlowField swarmField;
+    std::vector<Robot> swarm;
+
+    // Events of the last search; T replays them in place of the final explored set
+    SearchTrace searchTrace;
+    GridBitmap replayExpanded;
+    GridBitmap replayFrontier;
+    size_t replayCursor = 0;
+    float replayEvents = 0.0f;
+    bool replaying = false;
 
     sf::Font font;
     std::vector<Button> menuButtons;
@@ -60,14 +99,28 @@ private:
     void setupGameUI();
     void loadLevel();
     void updateMazePosition();
-    void computePath();
+    // Path from startPos; edited marks a replan after a cell change of the same maze
+    void computePath(bool edited = false);
+    void replanFrom(Point cell);
+    void beginBackgroundSearch(Point from);
+    void finishBackgroundSearch(PathJobResult& result);
+    bool usesHierarchy() const;
+    void planHierarchical(Point from);
+    bool refineNextSegment();
     void zoomIn();
     void zoomOut();
     void generateMaze();
     void toggleRunPause();
     void testMaze();
     void saveMaze();
+    void loadMaze();
     void resizeMaze();
+    // Flips the clicked cell between EMPTY and type; start and end stay put
+    void toggleCellAt(sf::Vector2f mousePos, CellType type);
+    void toggleSwarm();
+    void toggleReplay();
+    // Moves the replay to just before event target, rebuilding when going back
+    void seekReplay(size_t target);
 
     void handleMenuEvents(sf::Event& event, sf::RenderWindow& window);
     void handleOptionsEvents(sf::Event& event, sf::RenderWindow& window);
@@ -81,4 +134,6 @@ private:
     void drawExploredCells(sf::RenderWindow& window);
     void drawPathOverlay(sf::RenderWindow& window);
     void drawRobot(sf::RenderWindow& window);
+    void drawSwarm(sf::RenderWindow& window);
+    void drawReachable(sf::RenderWindow& window);
 };
\ No newline at end of file
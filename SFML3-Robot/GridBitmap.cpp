@@ -0,0 +1,51 @@
+#include "GridBitmap.h"
+#include <algorithm>
+#include <bitset>
+
+void GridBitmap::reset(int w, int h, bool value) {
+    width = w;
+    height = h;
+    wordsPerRow = (w + BITS - 1) / BITS;
+    bits.assign(static_cast<size_t>(wordsPerRow) * h, 0);
+    if (value) fill(true);
+}
+
+void GridBitmap::fill(bool value) {
+    if (!value) {
+        std::fill(bits.begin(), bits.end(), 0);
+        return;
+    }
+    if (wordsPerRow == 0) return;
+    for (int y = 0; y < height; ++y) {
+        std::uint64_t* r = row(y);
+        for (int w = 0; w < wordsPerRow; ++w) r[w] = ~std::uint64_t(0);
+        r[wordsPerRow - 1] = tailMask();
+    }
+}
+
+std::uint64_t GridBitmap::count() const {
+    std::uint64_t total = 0;
+    for (std::uint64_t w : bits) total += std::bitset<64>(w).count();
+    return total;
+}
+
+GridBitmap::const_iterator GridBitmap::begin() const {
+    const_iterator it;
+    it.owner = this;
+    if (bits.empty()) return it;
+    it.remaining = bits[0];
+    it.skipEmpty();
+    return it;
+}
+
+GridBitmap::const_iterator GridBitmap::end() const {
+    const_iterator it;
+    it.owner = this;
+    it.word = bits.size();
+    return it;
+}
+
+std::uint64_t GridBitmap::tailMask() const {
+    int used = width - (wordsPerRow - 1) * BITS;
+    return used >= BITS ? ~std::uint64_t(0) : ((std::uint64_t(1) << used) - 1);
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include "Point.h"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// One bit per cell, each row padded to whole 64-bit words so that word w of
+// row y covers cells x = w * 64 .. w * 64 + 63. Padding bits are always 0.
+class GridBitmap {
+public:
+    static constexpr int BITS = 64;
+
+    // Visits the set cells row by row, skipping empty words whole
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Point;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Point*;
+        using reference = Point;
+
+        const_iterator() = default;
+
+        Point operator*() const {
+            int w = static_cast<int>(word % owner->wordsPerRow);
+            return { w * BITS + lowestBit(remaining), static_cast<int>(word / owner->wordsPerRow) };
+        }
+        const_iterator& operator++() {
+            remaining &= remaining - 1;
+            skipEmpty();
+            return *this;
+        }
+        const_iterator operator++(int) { const_iterator old = *this; ++*this; return old; }
+        bool operator==(const const_iterator& other) const { return word == other.word && remaining == other.remaining; }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class GridBitmap;
+        const GridBitmap* owner = nullptr;
+        size_t word = 0;
+        std::uint64_t remaining = 0;
+
+        void skipEmpty() {
+            while (remaining == 0 && ++word < owner->bits.size()) remaining = owner->bits[word];
+        }
+    };
+
+    GridBitmap() = default;
+    GridBitmap(int w, int h, bool value = false) { reset(w, h, value); }
+
+    void reset(int w, int h, bool value = false);
+    void fill(bool value);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getWordsPerRow() const { return wordsPerRow; }
+
+    // Bounds-checked; outside the grid reads as 0
+    bool contains(Point p) const { return p.x >= 0 && p.x < width && p.y >= 0 && p.y < height && test(p.x, p.y); }
+    bool test(int x, int y) const {
+        return (bits[static_cast<size_t>(y) * wordsPerRow + (x >> 6)] >> (x & 63)) & 1u;
+    }
+    void set(int x, int y, bool value) {
+        std::uint64_t& w = bits[static_cast<size_t>(y) * wordsPerRow + (x >> 6)];
+        std::uint64_t mask = std::uint64_t(1) << (x & 63);
+        if (value) w |= mask; else w &= ~mask;
+    }
+
+    // Word access that treats everything outside the grid as 0
+    std::uint64_t word(int y, int w) const {
+        if (y < 0 || y >= height || w < 0 || w >= wordsPerRow) return 0;
+        return bits[static_cast<size_t>(y) * wordsPerRow + w];
+    }
+    std::uint64_t* row(int y) { return bits.data() + static_cast<size_t>(y) * wordsPerRow; }
+    const std::uint64_t* row(int y) const { return bits.data() + static_cast<size_t>(y) * wordsPerRow; }
+
+    std::uint64_t count() const;
+    size_t memoryBytes() const { return bits.size() * sizeof(std::uint64_t); }
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+private:
+    int width = 0, height = 0, wordsPerRow = 0;
+    std::vector<std::uint64_t> bits;
+
+    std::uint64_t tailMask() const;
+    // Index of the lowest set bit; w must not be 0
+    static int lowestBit(std::uint64_t w) {
+#if defined(_MSC_VER)
+        unsigned long i;
+        _BitScanForward64(&i, w);
+        return static_cast<int>(i);
+#else
+        return __builtin_ctzll(w);
+#endif
+    }
+};
@@ -0,0 +1,76 @@
+#pragma once
+#include "Enums.h"
+#include "Point.h"
+#include <cstddef>
+
+// Where each cell of a width x height grid lives in a flat array. ROW_MAJOR is
+// y * width + x. TILED stores 8x8 tiles one after another, each row-major
+// inside, so at one byte per cell a tile is one 64-byte cache line and a
+// vertical step usually stays in it. Tiled storage is padded to whole tiles;
+// the padding is never read through Maze's accessors.
+class GridLayout {
+public:
+    static constexpr int TILE_SHIFT = 3;
+    static constexpr int TILE = 1 << TILE_SHIFT;
+    static constexpr int TILE_MASK = TILE - 1;
+    static constexpr int TILE_CELLS = TILE * TILE;
+
+    GridLayout() = default;
+    GridLayout(int w, int h, CellLayout k) : kind(k), width(w), height(h) {
+        tilesPerRow = (w + TILE_MASK) >> TILE_SHIFT;
+        tileRowStride = tilesPerRow * TILE_CELLS;
+    }
+
+    CellLayout getKind() const { return kind; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    // Storage slots, padding included
+    size_t size() const {
+        if (kind == CellLayout::ROW_MAJOR) return static_cast<size_t>(width) * height;
+        return static_cast<size_t>(tileRowStride) * ((height + TILE_MASK) >> TILE_SHIFT);
+    }
+
+    int index(int x, int y) const {
+        if (kind == CellLayout::ROW_MAJOR) return y * width + x;
+        return (y >> TILE_SHIFT) * tileRowStride + ((x >> TILE_SHIFT) << (2 * TILE_SHIFT)) +
+            ((y & TILE_MASK) << TILE_SHIFT) + (x & TILE_MASK);
+    }
+    Point point(int i) const {
+        if (kind == CellLayout::ROW_MAJOR) return { i % width, i / width };
+        int tile = i >> (2 * TILE_SHIFT);
+        return { (tile % tilesPerRow) * TILE + (i & TILE_MASK), (tile / tilesPerRow) * TILE + ((i >> TILE_SHIFT) & TILE_MASK) };
+    }
+
+    // Storage distance from (x, y) to the neighbour one step away, so a kernel
+    // that walks by offsets never rebuilds an index. Whether the neighbour is
+    // inside the grid is the caller's check.
+    int east(int x) const {
+        if (kind == CellLayout::ROW_MAJOR || (x & TILE_MASK) != TILE_MASK) return 1;
+        return TILE_CELLS - TILE_MASK;
+    }
+    int west(int x) const {
+        if (kind == CellLayout::ROW_MAJOR || (x & TILE_MASK) != 0) return -1;
+        return -(TILE_CELLS - TILE_MASK);
+    }
+    int south(int y) const {
+        if (kind == CellLayout::ROW_MAJOR) return width;
+        return (y & TILE_MASK) != TILE_MASK ? TILE : tileRowStride - TILE_MASK * TILE;
+    }
+    int north(int y) const {
+        if (kind == CellLayout::ROW_MAJOR) return -width;
+        return (y & TILE_MASK) != 0 ? -TILE : -(tileRowStride - TILE_MASK * TILE);
+    }
+    // South, north, east, west: the order the search kernels list their directions in
+    void neighbourOffsets(int x, int y, int out[4]) const {
+        out[0] = south(y);
+        out[1] = north(y);
+        out[2] = east(x);
+        out[3] = west(x);
+    }
+
+private:
+    CellLayout kind = CellLayout::ROW_MAJOR;
+    int width = 0, height = 0;
+    int tilesPerRow = 0;
+    int tileRowStride = 0;
+};
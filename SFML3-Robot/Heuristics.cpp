@@ -1,6 +1,24 @@
 #include "Heuristics.h"
-#include <cmath>
+#include "LandmarkHeuristic.h"
 
 float ManhattanHeuristic::calculate(Point current, Point goal) {
-    return static_cast<float>(std::abs(current.x - goal.x) + std::abs(current.y - goal.y));
-}
\ No newline at end of file
+    return static_cast<float>(ManhattanDistance{}(current, goal));
+}
+
+float ZeroHeuristic::calculate(Point, Point) {
+    return 0.0f;
+}
+
+float OctileHeuristic::calculate(Point current, Point goal) {
+    return static_cast<float>(OctileDistance{}(current, goal));
+}
+
+std::unique_ptr<IHeuristic> makeHeuristic(HeuristicKind kind) {
+    switch (kind) {
+    case HeuristicKind::ZERO: return std::make_unique<ZeroHeuristic>();
+    case HeuristicKind::OCTILE: return std::make_unique<OctileHeuristic>();
+    // Needs LandmarkHeuristic::update before it beats Manhattan
+    case HeuristicKind::LANDMARK: return std::make_unique<LandmarkHeuristic>();
+    default: return std::make_unique<ManhattanHeuristic>();
+    }
+}
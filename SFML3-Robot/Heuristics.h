@@ -1,5 +1,29 @@
 #pragma once
 #include "Point.h"
+#include "Enums.h"
+#include <cstdlib>
+#include <memory>
+
+// Integer lower bounds on the number of 4-connected steps between two cells.
+// Templated searches take these by value so the call inlines into the loop.
+struct ManhattanDistance {
+    int operator()(Point a, Point b) const { return std::abs(a.x - b.x) + std::abs(a.y - b.y); }
+};
+
+// Turns A* into Dijkstra
+struct ZeroDistance {
+    int operator()(Point, Point) const { return 0; }
+};
+
+// max + (sqrt(2) - 1) * min, floored; weaker than Manhattan on a 4-connected grid
+// but still consistent, since one step changes it by at most one
+struct OctileDistance {
+    int operator()(Point a, Point b) const {
+        int dx = std::abs(a.x - b.x), dy = std::abs(a.y - b.y);
+        int hi = dx > dy ? dx : dy, lo = dx > dy ? dy : dx;
+        return hi + static_cast<int>(static_cast<long long>(lo) * 41421 / 100000);
+    }
+};
 
 class IHeuristic {
 public:
@@ -10,4 +34,16 @@ public:
 class ManhattanHeuristic : public IHeuristic {
 public:
     float calculate(Point current, Point goal) override;
-};
\ No newline at end of file
+};
+
+class ZeroHeuristic : public IHeuristic {
+public:
+    float calculate(Point current, Point goal) override;
+};
+
+class OctileHeuristic : public IHeuristic {
+public:
+    float calculate(Point current, Point goal) override;
+};
+
+std::unique_ptr<IHeuristic> makeHeuristic(HeuristicKind kind);
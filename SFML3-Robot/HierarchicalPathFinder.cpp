@@ -0,0 +1,382 @@
+#include "HierarchicalPathFinder.h"
+#include <algorithm>
+#include <cstdlib>
+
+HierarchicalPathFinder::HierarchicalPathFinder(int size) : clusterSize(std::max(2, size)) {
+}
+
+HierarchicalPathFinder::~HierarchicalPathFinder() {
+    detach();
+}
+
+void HierarchicalPathFinder::attach(const Maze& m) {
+    if (maze == &m) return;
+    detach();
+    maze = &m;
+    maze->addListener(this);
+    rebuild();
+}
+
+void HierarchicalPathFinder::detach() {
+    if (maze) maze->removeListener(this);
+    maze = nullptr;
+    nodes.clear();
+    freeNodes.clear();
+    clusters.clear();
+    eastBorder.clear();
+    southBorder.clear();
+    abstractPath.clear();
+}
+
+HierarchicalPathFinder::Bounds HierarchicalPathFinder::boundsOf(int cluster) const {
+    int cx = cluster % clustersX, cy = cluster / clustersX;
+    Bounds b;
+    b.x0 = cx * clusterSize;
+    b.y0 = cy * clusterSize;
+    b.x1 = std::min(maze->width, b.x0 + clusterSize) - 1;
+    b.y1 = std::min(maze->height, b.y0 + clusterSize) - 1;
+    return b;
+}
+
+void HierarchicalPathFinder::rebuild() {
+    clustersX = (maze->width + clusterSize - 1) / clusterSize;
+    clustersY = (maze->height + clusterSize - 1) / clusterSize;
+    int count = clustersX * clustersY;
+
+    nodes.clear();
+    freeNodes.clear();
+    clusters.assign(count, Cluster{});
+    eastBorder.assign(count, {});
+    southBorder.assign(count, {});
+
+    for (int c = 0; c < count; ++c) {
+        buildEastBorder(c);
+        buildSouthBorder(c);
+    }
+    // Growing by doubling can leave most of a huge maze's node array unused
+    nodes.shrink_to_fit();
+}
+
+int HierarchicalPathFinder::addNode(Point pos) {
+    int id;
+    if (!freeNodes.empty()) {
+        id = freeNodes.back();
+        freeNodes.pop_back();
+    }
+    else {
+        id = static_cast<int>(nodes.size());
+        nodes.push_back({});
+    }
+    int cluster = clusterOf(pos);
+    nodes[id] = { pos, cluster, static_cast<int>(clusters[cluster].nodes.size()), -1 };
+    clusters[cluster].nodes.push_back(id);
+    clusters[cluster].stale = true;
+    return id;
+}
+
+void HierarchicalPathFinder::addEntrance(std::vector<int>& border, Point a, Point b) {
+    int na = addNode(a), nb = addNode(b);
+    nodes[na].twin = nb;
+    nodes[nb].twin = na;
+    border.push_back(na);
+    border.push_back(nb);
+}
+
+void HierarchicalPathFinder::clearBorder(std::vector<int>& border) {
+    for (int id : border) {
+        auto& list = clusters[nodes[id].cluster].nodes;
+        list.erase(std::find(list.begin(), list.end(), id));
+        clusters[nodes[id].cluster].stale = true;
+        nodes[id].cluster = -1;
+        nodes[id].twin = -1;
+        freeNodes.push_back(id);
+    }
+    border.clear();
+}
+
+void HierarchicalPathFinder::buildEastBorder(int cluster) {
+    if (cluster % clustersX == clustersX - 1) return;
+    Bounds b = boundsOf(cluster);
+    int x = b.x1;
+
+    // One entrance in the middle of a short opening, one at each end of a long one
+    int y = b.y0;
+    while (y <= b.y1) {
+        if (maze->isWall({ x, y }) || maze->isWall({ x + 1, y })) { ++y; continue; }
+        int first = y;
+        while (y <= b.y1 && !maze->isWall({ x, y }) && !maze->isWall({ x + 1, y })) ++y;
+        int last = y - 1;
+        if (last - first + 1 < 6) {
+            int mid = (first + last) / 2;
+            addEntrance(eastBorder[cluster], { x, mid }, { x + 1, mid });
+        }
+        else {
+            addEntrance(eastBorder[cluster], { x, first }, { x + 1, first });
+            addEntrance(eastBorder[cluster], { x, last }, { x + 1, last });
+        }
+    }
+}
+
+void HierarchicalPathFinder::buildSouthBorder(int cluster) {
+    if (cluster / clustersX == clustersY - 1) return;
+    Bounds b = boundsOf(cluster);
+    int y = b.y1;
+
+    int x = b.x0;
+    while (x <= b.x1) {
+        if (maze->isWall({ x, y }) || maze->isWall({ x, y + 1 })) { ++x; continue; }
+        int first = x;
+        while (x <= b.x1 && !maze->isWall({ x, y }) && !maze->isWall({ x, y + 1 })) ++x;
+        int last = x - 1;
+        if (last - first + 1 < 6) {
+            int mid = (first + last) / 2;
+            addEntrance(southBorder[cluster], { mid, y }, { mid, y + 1 });
+        }
+        else {
+            addEntrance(southBorder[cluster], { first, y }, { first, y + 1 });
+            addEntrance(southBorder[cluster], { last, y }, { last, y + 1 });
+        }
+    }
+}
+
+void HierarchicalPathFinder::loadCluster(int cluster) {
+    loaded = boundsOf(cluster);
+    localOpen.assign(static_cast<size_t>(stride()) * stride(), 0);
+    for (int y = loaded.y0; y <= loaded.y1; ++y) {
+        for (int x = loaded.x0; x <= loaded.x1; ++x) {
+            localOpen[localIndex({ x, y })] = !maze->isWall({ x, y });
+        }
+    }
+}
+
+void HierarchicalPathFinder::localSearch(Point from, int targets) {
+    localDist.assign(localOpen.size(), -1);
+    localQueue.clear();
+    int start = localIndex(from);
+    if (!localOpen[start]) return;
+
+    int offsets[4] = { stride(), -stride(), 1, -1 };
+    localDist[start] = 0;
+    localQueue.push_back(start);
+    if (targets >= 0 && (targets -= localTargets[start]) <= 0) return;
+    for (size_t head = 0; head < localQueue.size(); ++head) {
+        int i = localQueue[head];
+        for (int offset : offsets) {
+            int n = i + offset;
+            if (!localOpen[n] || localDist[n] != -1) continue;
+            localDist[n] = localDist[i] + 1;
+            localQueue.push_back(n);
+            if (targets >= 0 && (targets -= localTargets[n]) <= 0) return;
+        }
+    }
+}
+
+void HierarchicalPathFinder::buildDistances(int cluster) {
+    Cluster& cl = clusters[cluster];
+    size_t n = cl.nodes.size();
+    cl.dist.assign(n * n, -1);
+    loadCluster(cluster);
+
+    // Distances are symmetric, so the search from node i only has to reach the
+    // nodes after it and can stop as soon as it has
+    localTargets.assign(localOpen.size(), 0);
+    for (int id : cl.nodes) localTargets[localIndex(nodes[id].pos)]++;
+    for (size_t i = 0; i < n; ++i) {
+        Point from = nodes[cl.nodes[i]].pos;
+        nodes[cl.nodes[i]].slot = static_cast<int>(i);
+        localTargets[localIndex(from)]--;
+        cl.dist[i * n + i] = 0;
+        if (i + 1 == n) break;
+        localSearch(from, static_cast<int>(n - i - 1));
+        for (size_t j = i + 1; j < n; ++j) {
+            int d = localDistanceTo(nodes[cl.nodes[j]].pos);
+            cl.dist[i * n + j] = d;
+            cl.dist[j * n + i] = d;
+        }
+    }
+    cl.stale = false;
+}
+
+const HierarchicalPathFinder::Cluster& HierarchicalPathFinder::distancesOf(int cluster) {
+    if (clusters[cluster].stale) buildDistances(cluster);
+    return clusters[cluster];
+}
+
+bool HierarchicalPathFinder::planAbstract(Point start, Point goal) {
+    abstractPath.clear();
+    expanded = 0;
+    if (!maze || maze->isWall(start) || maze->isWall(goal)) return false;
+
+    // Start and goal join the graph as two temporary nodes after the real ones
+    int n = static_cast<int>(nodes.size());
+    int startNode = n, goalNode = n + 1;
+    int startCluster = clusterOf(start), goalCluster = clusterOf(goal);
+    // goalDist is looked up by slot
+    distancesOf(goalCluster);
+
+    loadCluster(startCluster);
+    localSearch(start);
+    int direct = startCluster == goalCluster ? localDistanceTo(goal) : -1;
+    startDist.clear();
+    for (int id : clusters[startCluster].nodes) startDist.push_back(localDistanceTo(nodes[id].pos));
+    loadCluster(goalCluster);
+    localSearch(goal);
+    goalDist.clear();
+    for (int id : clusters[goalCluster].nodes) goalDist.push_back(localDistanceTo(nodes[id].pos));
+
+    auto position = [&](int id) { return id == startNode ? start : id == goalNode ? goal : nodes[id].pos; };
+    auto h = [&](int id) { Point p = position(id); return std::abs(p.x - goal.x) + std::abs(p.y - goal.y); };
+    auto worse = [](const OpenEntry& a, const OpenEntry& b) { return a.f > b.f || (a.f == b.f && a.g < b.g); };
+
+    abstractBuffers.prepare(n + 2);
+    abstractOpen.clear();
+    abstractBuffers.open(startNode, 0, -1);
+    abstractOpen.push_back({ h(startNode), 0, startNode });
+
+    auto relax = [&](int from, int g, int to, int cost) {
+        int tentative = g + cost;
+        if (abstractBuffers.isSeen(to) && abstractBuffers.gCost[to] <= tentative) return;
+        abstractBuffers.open(to, tentative, from);
+        abstractOpen.push_back({ tentative + h(to), tentative, to });
+        std::push_heap(abstractOpen.begin(), abstractOpen.end(), worse);
+    };
+
+    bool found = false;
+    while (!abstractOpen.empty()) {
+        std::pop_heap(abstractOpen.begin(), abstractOpen.end(), worse);
+        OpenEntry top = abstractOpen.back();
+        abstractOpen.pop_back();
+        if (abstractBuffers.isClosed(top.node) || top.g != abstractBuffers.gCost[top.node]) continue;
+        abstractBuffers.close(top.node);
+        expanded++;
+
+        if (top.node == goalNode) {
+            found = true;
+            break;
+        }
+
+        if (top.node == startNode) {
+            const auto& list = clusters[startCluster].nodes;
+            for (size_t j = 0; j < list.size(); ++j) {
+                if (startDist[j] >= 0) relax(top.node, top.g, list[j], startDist[j]);
+            }
+            if (direct >= 0) relax(top.node, top.g, goalNode, direct);
+            continue;
+        }
+
+        const Node& node = nodes[top.node];
+        if (node.twin >= 0) relax(top.node, top.g, node.twin, 1);
+        const Cluster& cl = distancesOf(node.cluster);
+        size_t size = cl.nodes.size();
+        for (size_t j = 0; j < size; ++j) {
+            int d = cl.dist[node.slot * size + j];
+            if (d >= 0 && static_cast<int>(j) != node.slot) relax(top.node, top.g, cl.nodes[j], d);
+        }
+        if (node.cluster == goalCluster && goalDist[node.slot] >= 0) {
+            relax(top.node, top.g, goalNode, goalDist[node.slot]);
+        }
+    }
+    if (!found) return false;
+
+    for (int id = goalNode; id != -1; id = abstractBuffers.parent[id]) {
+        Point p = position(id);
+        // Entrances of two borders can share a corner cell
+        if (abstractPath.empty() || abstractPath.back() != p) abstractPath.push_back(p);
+    }
+    std::reverse(abstractPath.begin(), abstractPath.end());
+    return true;
+}
+
+bool HierarchicalPathFinder::refineSegment(size_t i, std::vector<Point>& outCells) {
+    if (i + 1 >= abstractPath.size()) return false;
+    Point from = abstractPath[i], to = abstractPath[i + 1];
+    if (std::abs(from.x - to.x) + std::abs(from.y - to.y) == 1) {
+        outCells.push_back(to);
+        return true;
+    }
+
+    // Both waypoints lie in one cluster: walk the BFS distances back from the target
+    loadCluster(clusterOf(from));
+    localSearch(from);
+    if (localDistanceTo(to) < 0) return false;
+
+    Point directions[4] = { {0,1},{0,-1},{1,0},{-1,0} };
+    size_t first = outCells.size();
+    Point p = to;
+    outCells.push_back(p);
+    while (localDistanceTo(p) > 1) {
+        int d = localDistanceTo(p);
+        for (Point dir : directions) {
+            Point n = { p.x + dir.x, p.y + dir.y };
+            // The margin around the loaded cluster reads as unreached
+            if (localDistanceTo(n) == d - 1) {
+                p = n;
+                break;
+            }
+        }
+        outCells.push_back(p);
+    }
+    std::reverse(outCells.begin() + first, outCells.end());
+    return true;
+}
+
+bool HierarchicalPathFinder::findPath(Point start, Point goal, std::vector<Point>& outPath) {
+    outPath.clear();
+    if (!planAbstract(start, goal)) return false;
+    outPath.push_back(start);
+    for (size_t i = 0; i + 1 < abstractPath.size(); ++i) {
+        if (!refineSegment(i, outPath)) return false;
+    }
+    return true;
+}
+
+size_t HierarchicalPathFinder::memoryBytes() const {
+    size_t bytes = nodes.capacity() * sizeof(Node) + freeNodes.capacity() * sizeof(int);
+    for (const Cluster& cl : clusters) {
+        bytes += sizeof(Cluster) + (cl.nodes.capacity() + cl.dist.capacity()) * sizeof(int);
+    }
+    for (const auto& border : eastBorder) bytes += sizeof(border) + border.capacity() * sizeof(int);
+    for (const auto& border : southBorder) bytes += sizeof(border) + border.capacity() * sizeof(int);
+    return bytes;
+}
+
+void HierarchicalPathFinder::onCellChanged(const Maze& m, int x, int y, CellType oldType) {
+    if (&m != maze) return;
+    if ((oldType == CellType::WALL) == m.isWall({ x, y })) return;
+
+    int cluster = clusterOf({ x, y });
+    Bounds b = boundsOf(cluster);
+    int cx = cluster % clustersX, cy = cluster / clustersX;
+
+    // Entrances only depend on border cells; an interior change just alters distances
+    bool onBorder = x == b.x0 || x == b.x1 || y == b.y0 || y == b.y1;
+    if (onBorder) {
+        int west = cx > 0 ? cluster - 1 : -1;
+        int north = cy > 0 ? cluster - clustersX : -1;
+        clearBorder(eastBorder[cluster]);
+        clearBorder(southBorder[cluster]);
+        if (west >= 0) clearBorder(eastBorder[west]);
+        if (north >= 0) clearBorder(southBorder[north]);
+        buildEastBorder(cluster);
+        buildSouthBorder(cluster);
+        if (west >= 0) buildEastBorder(west);
+        if (north >= 0) buildSouthBorder(north);
+    }
+    // Rebuilding the borders marked the clusters along them; the next query redoes them
+    clusters[cluster].stale = true;
+}
+
+void HierarchicalPathFinder::onMazeReset(const Maze& m) {
+    if (&m == maze) rebuild();
+}
+
+void HierarchicalPathFinder::onMazeDestroyed(const Maze& m) {
+    if (&m != maze) return;
+    maze = nullptr;
+    nodes.clear();
+    freeNodes.clear();
+    clusters.clear();
+    eastBorder.clear();
+    southBorder.clear();
+    abstractPath.clear();
+}
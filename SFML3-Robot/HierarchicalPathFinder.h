@@ -0,0 +1,96 @@
+#pragma once
+#include "Maze.h"
+#include "Point.h"
+#include "SearchBuffers.h"
+#include <vector>
+
+// HPA*: the grid is cut into square clusters, every open stretch of a cluster
+// border gets one or two entrance pairs, and the entrances of a cluster are
+// linked by their in-cluster distances. Queries search this small abstract graph
+// and the cell path is refined one segment at a time. Attaching only scans the
+// borders; a cluster's distances are computed the first time a query enters it.
+// The graph listens to its maze and only redoes the cluster (and borders) around
+// a changed cell.
+class HierarchicalPathFinder : public IMazeListener {
+public:
+    explicit HierarchicalPathFinder(int clusterSize = 16);
+    HierarchicalPathFinder(const HierarchicalPathFinder&) = delete;
+    HierarchicalPathFinder& operator=(const HierarchicalPathFinder&) = delete;
+    ~HierarchicalPathFinder() override;
+
+    void attach(const Maze& maze);
+    void detach();
+
+    // Waypoints from start to goal; consecutive waypoints share a cluster
+    bool planAbstract(Point start, Point goal);
+    const std::vector<Point>& getAbstractPath() const { return abstractPath; }
+    // Appends the cells after waypoint i up to and including waypoint i + 1
+    bool refineSegment(size_t i, std::vector<Point>& outCells);
+    bool findPath(Point start, Point goal, std::vector<Point>& outPath);
+
+    int getClusterSize() const { return clusterSize; }
+    int getNodeCount() const { return static_cast<int>(nodes.size() - freeNodes.size()); }
+    int getExpanded() const { return expanded; }
+    size_t memoryBytes() const;
+
+    void onCellChanged(const Maze& maze, int x, int y, CellType oldType) override;
+    void onMazeReset(const Maze& maze) override;
+    void onMazeDestroyed(const Maze& maze) override;
+
+private:
+    struct Node { Point pos; int cluster; int slot; int twin; };
+    struct Cluster {
+        std::vector<int> nodes;
+        // nodes.size()^2 in-cluster distances, -1 when not connected inside the cluster
+        std::vector<int> dist;
+        // dist (and the nodes' slots) no longer match nodes
+        bool stale = true;
+    };
+    struct Bounds { int x0, y0, x1, y1; };
+    struct OpenEntry { int f; int g; int node; };
+
+    const Maze* maze = nullptr;
+    int clusterSize;
+    int clustersX = 0, clustersY = 0;
+
+    std::vector<Node> nodes;
+    std::vector<int> freeNodes;
+    std::vector<Cluster> clusters;
+    // Entrance nodes (both sides) on the east and south border of each cluster
+    std::vector<std::vector<int>> eastBorder, southBorder;
+
+    std::vector<Point> abstractPath;
+    int expanded = 0;
+
+    // Scratch space
+    SearchBuffers abstractBuffers;
+    std::vector<OpenEntry> abstractOpen;
+    // One cluster copied into a grid with a one-cell wall margin, so the BFS needs
+    // no bounds checks
+    Bounds loaded{ 0, 0, -1, -1 };
+    std::vector<char> localOpen;
+    std::vector<int> localDist;
+    std::vector<int> localQueue;
+    // Number of graph nodes on each cell of the loaded cluster
+    std::vector<int> localTargets;
+    std::vector<int> startDist, goalDist;
+
+    int clusterOf(Point p) const { return (p.y / clusterSize) * clustersX + p.x / clusterSize; }
+    Bounds boundsOf(int cluster) const;
+
+    void rebuild();
+    void clearBorder(std::vector<int>& border);
+    void buildEastBorder(int cluster);
+    void buildSouthBorder(int cluster);
+    void addEntrance(std::vector<int>& border, Point a, Point b);
+    int addNode(Point pos);
+    void buildDistances(int cluster);
+    const Cluster& distancesOf(int cluster);
+    int stride() const { return clusterSize + 2; }
+    int localIndex(Point p) const { return (p.y - loaded.y0 + 1) * stride() + (p.x - loaded.x0 + 1); }
+    void loadCluster(int cluster);
+    // BFS inside the loaded cluster; localDist holds -1 for unreached cells. With
+    // targets >= 0 the search stops once that many localTargets have been reached
+    void localSearch(Point from, int targets = -1);
+    int localDistanceTo(Point p) const { return localDist[localIndex(p)]; }
+};
@@ -0,0 +1,172 @@
+#include "IncrementalPathFinder.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+namespace {
+    // Large enough to mean "no path", small enough that adding a step cannot overflow
+    const int UNREACHED = INT_MAX / 2;
+}
+
+IncrementalPathFinder::~IncrementalPathFinder() {
+    detach();
+}
+
+void IncrementalPathFinder::attach(const Maze& m) {
+    if (maze == &m) return;
+    detach();
+    maze = &m;
+    maze->addListener(this);
+}
+
+void IncrementalPathFinder::detach() {
+    if (maze) maze->removeListener(this);
+    maze = nullptr;
+    initialised = false;
+}
+
+void IncrementalPathFinder::reset() {
+    g.assign(maze->cellCount(), UNREACHED);
+    rhs.assign(maze->cellCount(), UNREACHED);
+    open.clear();
+    int s = maze->index(start.x, start.y);
+    rhs[s] = 0;
+    open.push_back(keyOf(s));
+    initialised = true;
+}
+
+IncrementalPathFinder::OpenEntry IncrementalPathFinder::keyOf(int index) const {
+    int best = std::min(g[index], rhs[index]);
+    int x = index % maze->width, y = index / maze->width;
+    return { best + std::abs(x - goal.x) + std::abs(y - goal.y), best, index };
+}
+
+bool IncrementalPathFinder::isStale(const OpenEntry& entry) const {
+    if (g[entry.index] == rhs[entry.index]) return true;
+    OpenEntry current = keyOf(entry.index);
+    return current.f != entry.f || current.g != entry.g;
+}
+
+void IncrementalPathFinder::updateCell(int index) {
+    int x = index % maze->width, y = index / maze->width;
+    if (maze->isWall({ x, y })) {
+        rhs[index] = UNREACHED;
+    }
+    else if (x == start.x && y == start.y) {
+        rhs[index] = 0;
+    }
+    else {
+        Point neighbours[4] = { { x, y + 1 }, { x, y - 1 }, { x + 1, y }, { x - 1, y } };
+        int best = UNREACHED;
+        for (Point n : neighbours) {
+            if (!maze->isWall(n)) best = std::min(best, g[maze->index(n.x, n.y)] + 1);
+        }
+        rhs[index] = std::min(best, UNREACHED);
+    }
+    if (g[index] != rhs[index]) {
+        open.push_back(keyOf(index));
+        std::push_heap(open.begin(), open.end(), worse);
+        if (recording) recording->push(index, open.back().g);
+    }
+}
+
+void IncrementalPathFinder::computeShortestPath() {
+    int goalIndex = maze->index(goal.x, goal.y);
+    while (true) {
+        while (!open.empty() && isStale(open.front())) {
+            std::pop_heap(open.begin(), open.end(), worse);
+            open.pop_back();
+        }
+        if (open.empty()) break;
+        // Done once nothing queued can improve the goal and the goal itself is settled
+        if (!worse(keyOf(goalIndex), open.front()) && g[goalIndex] == rhs[goalIndex]) break;
+
+        std::pop_heap(open.begin(), open.end(), worse);
+        int u = open.back().index;
+        if (recording) recording->expand(u, open.back().g);
+        open.pop_back();
+        expandedCells.push_back(u);
+
+        if (g[u] > rhs[u]) g[u] = rhs[u];
+        else {
+            g[u] = UNREACHED;
+            updateCell(u);
+        }
+        int x = u % maze->width, y = u / maze->width;
+        Point neighbours[4] = { { x, y + 1 }, { x, y - 1 }, { x + 1, y }, { x - 1, y } };
+        for (Point n : neighbours) {
+            if (maze->isValid(n)) updateCell(maze->index(n.x, n.y));
+        }
+    }
+}
+
+bool IncrementalPathFinder::findPath(Point s, Point t, std::vector<Point>& outPath, SearchTrace* trace) {
+    outPath.clear();
+    expandedCells.clear();
+    if (!maze || maze->isWall(s) || maze->isWall(t)) return false;
+
+    if (!initialised || s != start || t != goal) {
+        start = s;
+        goal = t;
+        reset();
+    }
+    if (trace) {
+        for (const OpenEntry& entry : open) {
+            if (!isStale(entry)) trace->push(entry.index, entry.g);
+        }
+    }
+    recording = trace;
+    computeShortestPath();
+    recording = nullptr;
+
+    int current = maze->index(goal.x, goal.y);
+    if (g[current] >= UNREACHED) return false;
+
+    // Walk back along neighbours whose g is one less
+    Point p = goal;
+    outPath.push_back(p);
+    while (p != start) {
+        Point neighbours[4] = { { p.x, p.y + 1 }, { p.x, p.y - 1 }, { p.x + 1, p.y }, { p.x - 1, p.y } };
+        Point next = p;
+        for (Point n : neighbours) {
+            if (!maze->isWall(n) && g[maze->index(n.x, n.y)] == g[maze->index(p.x, p.y)] - 1) {
+                next = n;
+                break;
+            }
+        }
+        if (next == p) {
+            outPath.clear();
+            return false;
+        }
+        p = next;
+        outPath.push_back(p);
+    }
+    std::reverse(outPath.begin(), outPath.end());
+    return true;
+}
+
+size_t IncrementalPathFinder::memoryBytes() const {
+    return (g.capacity() + rhs.capacity()) * sizeof(int) + open.capacity() * sizeof(OpenEntry);
+}
+
+void IncrementalPathFinder::onCellChanged(const Maze& m, int x, int y, CellType oldType) {
+    if (&m != maze || !initialised) return;
+    if ((oldType == CellType::WALL) == m.isWall({ x, y })) return;
+
+    // Only the changed cell and the edges into its neighbours are affected
+    updateCell(m.index(x, y));
+    Point neighbours[4] = { { x, y + 1 }, { x, y - 1 }, { x + 1, y }, { x - 1, y } };
+    for (Point n : neighbours) {
+        if (m.isValid(n)) updateCell(m.index(n.x, n.y));
+    }
+}
+
+void IncrementalPathFinder::onMazeReset(const Maze& m) {
+    if (&m == maze) initialised = false;
+}
+
+void IncrementalPathFinder::onMazeDestroyed(const Maze& m) {
+    if (&m != maze) return;
+    maze = nullptr;
+    initialised = false;
+}
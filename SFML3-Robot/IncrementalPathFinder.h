@@ -0,0 +1,55 @@
+#pragma once
+#include "Maze.h"
+#include "Point.h"
+#include "SearchTrace.h"
+#include <vector>
+
+// Lifelong Planning A*: g and rhs values for every cell survive between queries.
+// The planner listens to its maze, so when setCell flips a few cells only the
+// part of the search they invalidate is repaired on the next findPath. A new
+// start or goal, or a whole-maze change, starts the search over.
+class IncrementalPathFinder : public IMazeListener {
+public:
+    IncrementalPathFinder() = default;
+    IncrementalPathFinder(const IncrementalPathFinder&) = delete;
+    IncrementalPathFinder& operator=(const IncrementalPathFinder&) = delete;
+    ~IncrementalPathFinder() override;
+
+    void attach(const Maze& maze);
+    void detach();
+    const Maze* getMaze() const { return maze; }
+
+    // With a trace (already begun, not owned) the repair is recorded: the queue it
+    // starts from as pushes, then every expansion and requeue
+    bool findPath(Point start, Point goal, std::vector<Point>& outPath, SearchTrace* trace = nullptr);
+    // Cell indices expanded by the last findPath
+    const std::vector<int>& getExpanded() const { return expandedCells; }
+    // g of a cell after the last findPath
+    int getCost(int index) const { return g[index]; }
+    size_t memoryBytes() const;
+
+    void onCellChanged(const Maze& maze, int x, int y, CellType oldType) override;
+    void onMazeReset(const Maze& maze) override;
+    void onMazeDestroyed(const Maze& maze) override;
+
+private:
+    // Key [min(g, rhs) + h; min(g, rhs)] of the cell when it was queued
+    struct OpenEntry { int f; int g; int index; };
+    static bool worse(const OpenEntry& a, const OpenEntry& b) { return a.f > b.f || (a.f == b.f && a.g > b.g); }
+
+    const Maze* maze = nullptr;
+    bool initialised = false;
+    Point start{ -1, -1 }, goal{ -1, -1 };
+    std::vector<int> g, rhs;
+    // Heap with lazy deletion: entries whose key no longer matches are skipped
+    std::vector<OpenEntry> open;
+    std::vector<int> expandedCells;
+    // Only set during findPath; cells queued by edits in between are not recorded
+    SearchTrace* recording = nullptr;
+
+    void reset();
+    OpenEntry keyOf(int index) const;
+    bool isStale(const OpenEntry& entry) const;
+    void updateCell(int index);
+    void computeShortestPath();
+};
@@ -0,0 +1,146 @@
+#include "JumpTable.h"
+#include <algorithm>
+#include <cstdlib>
+
+JumpTable::~JumpTable() {
+    detach();
+}
+
+void JumpTable::attach(const Maze& m) {
+    if (maze == &m) return;
+    detach();
+    maze = &m;
+    maze->addListener(this);
+    rebuild();
+}
+
+void JumpTable::detach() {
+    if (maze) maze->removeListener(this);
+    maze = nullptr;
+    table.clear();
+}
+
+bool JumpTable::hasHorizontalJump(int x, int y) const {
+    int i = maze->index(x, y);
+    return distance(i, EAST) > 0 || distance(i, WEST) > 0;
+}
+
+void JumpTable::rebuild() {
+    table.assign(static_cast<size_t>(maze->cellCount()) * DIRECTION_COUNT, 0);
+    for (int y = 0; y < maze->height; ++y) buildRow(y);
+    for (int x = 0; x < maze->width; ++x) buildColumn(x);
+}
+
+void JumpTable::buildRow(int y) {
+    const Maze& m = *maze;
+    // A horizontal step onto q is forced when a vertical neighbour of q is open
+    // but the same neighbour of the cell we came from is not
+    auto forced = [&](int qx, int dx) {
+        return (!m.isWall({ qx, y - 1 }) && m.isWall({ qx - dx, y - 1 })) ||
+            (!m.isWall({ qx, y + 1 }) && m.isWall({ qx - dx, y + 1 }));
+    };
+    auto extend = [](std::int32_t next) { return next > 0 ? next + 1 : next - 1; };
+
+    for (int x = m.width - 1; x >= 0; --x) {
+        std::int32_t& d = at(x, y, EAST);
+        if (m.isWall({ x, y }) || m.isWall({ x + 1, y })) d = 0;
+        else if (forced(x + 1, 1)) d = 1;
+        else d = extend(at(x + 1, y, EAST));
+    }
+    for (int x = 0; x < m.width; ++x) {
+        std::int32_t& d = at(x, y, WEST);
+        if (m.isWall({ x, y }) || m.isWall({ x - 1, y })) d = 0;
+        else if (forced(x - 1, -1)) d = 1;
+        else d = extend(at(x - 1, y, WEST));
+    }
+}
+
+void JumpTable::buildColumn(int x) {
+    const Maze& m = *maze;
+    auto extend = [](std::int32_t next) { return next > 0 ? next + 1 : next - 1; };
+
+    // Vertical runs stop on any cell that has a horizontal jump point
+    for (int y = m.height - 1; y >= 0; --y) {
+        std::int32_t& d = at(x, y, SOUTH);
+        if (m.isWall({ x, y }) || m.isWall({ x, y + 1 })) d = 0;
+        else if (hasHorizontalJump(x, y + 1)) d = 1;
+        else d = extend(at(x, y + 1, SOUTH));
+    }
+    for (int y = 0; y < m.height; ++y) {
+        std::int32_t& d = at(x, y, NORTH);
+        if (m.isWall({ x, y }) || m.isWall({ x, y - 1 })) d = 0;
+        else if (hasHorizontalJump(x, y - 1)) d = 1;
+        else d = extend(at(x, y - 1, NORTH));
+    }
+}
+
+bool JumpTable::jump(Point p, int dx, int dy, Point goal, Point& jumpPoint) const {
+    int i = maze->index(p.x, p.y);
+    if (dy == 0) {
+        int d = distance(i, dx > 0 ? EAST : WEST);
+        int reach = d > 0 ? d : -d;
+        int k = dx * (goal.x - p.x);
+        if (goal.y == p.y && k > 0 && k <= reach) {
+            jumpPoint = goal;
+            return true;
+        }
+        if (d <= 0) return false;
+        jumpPoint = { p.x + dx * d, p.y };
+        return true;
+    }
+
+    int d = distance(i, dy > 0 ? SOUTH : NORTH);
+    int reach = d > 0 ? d : -d;
+    int k = dy * (goal.y - p.y);
+    if (k > 0 && k <= reach && (d <= 0 || k < d)) {
+        // The run crosses the goal's row before any jump point: stop there if the
+        // goal is in a straight open line from the crossing cell
+        Point crossing = { p.x, goal.y };
+        int toGoal = std::abs(goal.x - p.x);
+        int side = distance(maze->index(crossing.x, crossing.y), goal.x > p.x ? EAST : WEST);
+        if (toGoal == 0 || side > 0 || -side >= toGoal) {
+            jumpPoint = crossing;
+            return true;
+        }
+    }
+    if (d <= 0) return false;
+    jumpPoint = { p.x, p.y + dy * d };
+    return true;
+}
+
+void JumpTable::onCellChanged(const Maze& m, int x, int y, CellType oldType) {
+    if (&m != maze) return;
+    bool wasWall = oldType == CellType::WALL;
+    if (wasWall == m.isWall({ x, y })) return;
+
+    // Horizontal entries read this row and its vertical neighbours
+    int firstRow = std::max(0, y - 1), lastRow = std::min(m.height - 1, y + 1);
+    std::vector<char> before;
+    for (int r = firstRow; r <= lastRow; ++r) {
+        for (int c = 0; c < m.width; ++c) before.push_back(hasHorizontalJump(c, r));
+    }
+    for (int r = firstRow; r <= lastRow; ++r) buildRow(r);
+
+    // Vertical entries only change in columns whose horizontal jump flags moved
+    std::vector<char> dirtyColumn(m.width, 0);
+    dirtyColumn[x] = 1;
+    size_t k = 0;
+    for (int r = firstRow; r <= lastRow; ++r) {
+        for (int c = 0; c < m.width; ++c, ++k) {
+            if (before[k] != static_cast<char>(hasHorizontalJump(c, r))) dirtyColumn[c] = 1;
+        }
+    }
+    for (int c = 0; c < m.width; ++c) {
+        if (dirtyColumn[c]) buildColumn(c);
+    }
+}
+
+void JumpTable::onMazeReset(const Maze& m) {
+    if (&m == maze) rebuild();
+}
+
+void JumpTable::onMazeDestroyed(const Maze& m) {
+    if (&m != maze) return;
+    maze = nullptr;
+    table.clear();
+}
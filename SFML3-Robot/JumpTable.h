@@ -0,0 +1,45 @@
+#pragma once
+#include "Maze.h"
+#include "Point.h"
+#include <cstdint>
+#include <vector>
+
+// JPS+ preprocessing: for every cell and direction, the distance to the next
+// jump point (> 0) or, when the run ends in a wall first, minus the number of
+// open steps before that wall (<= 0). Jump points follow the same canonical
+// rules as the online JPS in PathFinder. The table listens to its maze and
+// repairs only the rows and columns a setCell can affect.
+class JumpTable : public IMazeListener {
+public:
+    enum Direction { EAST, WEST, SOUTH, NORTH, DIRECTION_COUNT };
+
+    JumpTable() = default;
+    JumpTable(const JumpTable&) = delete;
+    JumpTable& operator=(const JumpTable&) = delete;
+    ~JumpTable() override;
+
+    void attach(const Maze& maze);
+    void detach();
+    const Maze* getMaze() const { return maze; }
+
+    int distance(int index, Direction dir) const { return table[static_cast<size_t>(index) * DIRECTION_COUNT + dir]; }
+    // Jump from p in dir, stopping early at goal; false if the run hits a wall first
+    bool jump(Point p, int dx, int dy, Point goal, Point& jumpPoint) const;
+
+    size_t memoryBytes() const { return table.size() * sizeof(std::int32_t); }
+
+    void onCellChanged(const Maze& maze, int x, int y, CellType oldType) override;
+    void onMazeReset(const Maze& maze) override;
+    void onMazeDestroyed(const Maze& maze) override;
+
+private:
+    const Maze* maze = nullptr;
+    std::vector<std::int32_t> table;
+
+    std::int32_t& at(int x, int y, Direction dir) { return table[static_cast<size_t>(maze->index(x, y)) * DIRECTION_COUNT + dir]; }
+    bool hasHorizontalJump(int x, int y) const;
+
+    void rebuild();
+    void buildRow(int y);
+    void buildColumn(int x);
+};
@@ -0,0 +1,80 @@
+#include "LandmarkHeuristic.h"
+#include <climits>
+
+LandmarkHeuristic::LandmarkHeuristic(int landmarks) : landmarkCount(std::max(1, landmarks)) {
+}
+
+// Fills dist with BFS distances from one cell (-1 where unreached); returns the farthest cell's index
+int LandmarkHeuristic::bfs(const Maze& maze, Point from) {
+    dist.assign(maze.cellCount(), -1);
+    queue.clear();
+    int start = maze.index(from.x, from.y);
+    dist[start] = 0;
+    queue.push_back(start);
+    Point directions[4] = { {0,1},{0,-1},{1,0},{-1,0} };
+    int offsets[4] = { maze.width, -maze.width, 1, -1 };
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int i = queue[head];
+        Point p = { i % maze.width, i / maze.width };
+        for (int d = 0; d < 4; ++d) {
+            if (maze.isWall({ p.x + directions[d].x, p.y + directions[d].y })) continue;
+            int n = i + offsets[d];
+            if (dist[n] != -1) continue;
+            dist[n] = dist[i] + 1;
+            queue.push_back(n);
+        }
+    }
+    return queue.back();
+}
+
+void LandmarkHeuristic::update(const Maze& maze) {
+    if (isCurrent(maze)) return;
+    source = &maze;
+    version = maze.getVersion();
+    width = maze.width;
+    height = maze.height;
+    count = 0;
+    wide = false;
+    table.clear();
+    wideTable.clear();
+    landmarks.clear();
+
+    Point seed = maze.startPos;
+    for (int i = 0; maze.isWall(seed) && i < maze.cellCount(); ++i) seed = { i % width, i / width };
+    if (maze.isWall(seed)) return;
+
+    // Farthest-point selection: the first landmark is the cell farthest from the
+    // seed, each further one the cell farthest from all landmarks so far. Only the
+    // seed's region is covered; elsewhere the bound falls back to Manhattan.
+    std::vector<int> nearest(maze.cellCount(), INT_MAX);
+    int next = bfs(maze, seed);
+    count = landmarkCount;
+    size_t size = static_cast<size_t>(maze.cellCount()) * count;
+    for (int k = 0; k < landmarkCount; ++k) {
+        Point landmark = { next % width, next / width };
+        int farthestFromLandmark = bfs(maze, landmark);
+        landmarks.push_back(landmark);
+        if (k == 0) {
+            // No distance in the region exceeds twice the first landmark's eccentricity
+            wide = 2 * dist[farthestFromLandmark] >= UNREACHED;
+            if (wide) wideTable.assign(size, WIDE_UNREACHED);
+            else table.assign(size, UNREACHED);
+        }
+
+        int farthest = -1, farthestDistance = 0;
+        for (int i = 0; i < maze.cellCount(); ++i) {
+            if (dist[i] < 0) continue;
+            size_t slot = static_cast<size_t>(i) * count + k;
+            if (wide) wideTable[slot] = static_cast<std::uint32_t>(dist[i]);
+            else table[slot] = static_cast<std::uint16_t>(dist[i]);
+            nearest[i] = std::min(nearest[i], dist[i]);
+            if (nearest[i] > farthestDistance) {
+                farthestDistance = nearest[i];
+                farthest = i;
+            }
+        }
+        // Every cell of the region is already a landmark; the spare slots stay unreached
+        if (farthest < 0) break;
+        next = farthest;
+    }
+}
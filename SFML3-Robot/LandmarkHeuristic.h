@@ -0,0 +1,74 @@
+#pragma once
+#include "Heuristics.h"
+#include "Maze.h"
+#include "Point.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// ALT heuristic: BFS distances from a few landmarks bound the distance between
+// any two cells through the triangle inequality, |d(a, L) - d(b, L)| <= d(a, b).
+// Landmarks are picked by farthest-point selection so they sit at the ends of
+// long corridors, where the bound is tight. Distances are stored in 16 bits and
+// only widened to 32 when the maze has a distance that does not fit; rounding
+// them instead would make the bound inconsistent, which the searches rely on.
+class LandmarkHeuristic : public IHeuristic {
+public:
+    explicit LandmarkHeuristic(int landmarkCount = 8);
+
+    // Rebuilds the tables when the maze or its version changed
+    void update(const Maze& maze);
+    bool isCurrent(const Maze& maze) const { return source == &maze && version == maze.getVersion(); }
+
+    // Never below Manhattan; falls back to it before the first update
+    int distance(Point a, Point b) const {
+        int best = ManhattanDistance{}(a, b);
+        if (count == 0 || !inside(a) || !inside(b)) return best;
+        size_t ia = (static_cast<size_t>(a.y) * width + a.x) * count;
+        size_t ib = (static_cast<size_t>(b.y) * width + b.x) * count;
+        if (wide) return bound(&wideTable[ia], &wideTable[ib], best, WIDE_UNREACHED);
+        return bound(&table[ia], &table[ib], best, UNREACHED);
+    }
+    float calculate(Point current, Point goal) override { return static_cast<float>(distance(current, goal)); }
+
+    const std::vector<Point>& getLandmarks() const { return landmarks; }
+    size_t memoryBytes() const { return table.capacity() * sizeof(std::uint16_t) + wideTable.capacity() * sizeof(std::uint32_t); }
+
+private:
+    static constexpr std::uint16_t UNREACHED = 0xFFFF;
+    static constexpr std::uint32_t WIDE_UNREACHED = 0xFFFFFFFF;
+
+    int landmarkCount;
+    const Maze* source = nullptr;
+    std::uint64_t version = 0;
+    int width = 0, height = 0;
+    // Cell-major: the distances of one cell to every landmark are adjacent
+    int count = 0;
+    bool wide = false;
+    std::vector<std::uint16_t> table;
+    std::vector<std::uint32_t> wideTable;
+    std::vector<Point> landmarks;
+
+    // Scratch for the builds
+    std::vector<int> dist;
+    std::vector<int> queue;
+
+    bool inside(Point p) const { return p.x >= 0 && p.x < width && p.y >= 0 && p.y < height; }
+    int bfs(const Maze& maze, Point from);
+
+    template <typename T>
+    int bound(const T* da, const T* db, int best, T unreached) const {
+        for (int k = 0; k < count; ++k) {
+            if (da[k] == unreached || db[k] == unreached) continue;
+            int diff = static_cast<int>(da[k] > db[k] ? da[k] - db[k] : db[k] - da[k]);
+            best = std::max(best, diff);
+        }
+        return best;
+    }
+};
+
+// Non-owning functor for the templated searches
+struct LandmarkDistance {
+    const LandmarkHeuristic* table;
+    int operator()(Point a, Point b) const { return table->distance(a, b); }
+};
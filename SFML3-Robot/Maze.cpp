@@ -1,89 +1,252 @@
 #include "Maze.h"
+#include "Connectivity.h"
 #include "MazeGenerator.h"
 #include <algorithm>
+#include <atomic>
 #include <string>
 
-Maze::Maze(int w, int h) : width(w), height(h) {
+namespace {
+    std::atomic<std::uint64_t> lastVersion{ 0 };
+}
+
+template <typename Notify>
+void Maze::notifyListeners(Notify&& notify) const {
+    // Listeners often detach themselves, or others, while being notified. By
+    // index, so that additions cannot invalidate the loop; removals only null
+    // the entry until the outermost notification is over
+    notifying++;
+    size_t count = listeners.size();
+    for (size_t i = 0; i < count; ++i) {
+        if (listeners[i]) notify(listeners[i]);
+    }
+    if (--notifying == 0) listeners.erase(std::remove(listeners.begin(), listeners.end(), nullptr), listeners.end());
+}
+
+Maze::Maze() {
+    touch();
+}
+
+Maze::Maze(int w, int h, CellLayout kind) : width(w), height(h), layout(w, h, kind) {
     initializeGrid();
+    touch();
 }
 
-void Maze::initializeGrid() {
-    grid.resize(height);
-    for (int y = 0; y < height; ++y) {
-        grid[y].resize(width);
-        for (int x = 0; x < width; ++x) {
-            grid[y][x] = Cell::create(CellType::EMPTY, { x,y });
-        }
+Maze::Maze(const Maze& other)
+    : width(other.width), height(other.height), startPos(other.startPos), endPos(other.endPos),
+    cells(other.cells), layout(other.layout), walkable(other.walkable),
+    costs(other.costs), weightedCells(other.weightedCells), openCosts(other.openCosts) {
+    touch();
+}
+
+Maze& Maze::operator=(const Maze& other) {
+    if (this != &other) {
+        width = other.width;
+        height = other.height;
+        startPos = other.startPos;
+        endPos = other.endPos;
+        cells = other.cells;
+        layout = other.layout;
+        walkable = other.walkable;
+        costs = other.costs;
+        weightedCells = other.weightedCells;
+        openCosts = other.openCosts;
+        notifyReset();
+    }
+    return *this;
+}
+
+Maze::~Maze() {
+    notifyListeners([this](IMazeListener* l) { l->onMazeDestroyed(*this); });
+}
+
+void Maze::addListener(IMazeListener* listener) const {
+    if (std::find(listeners.begin(), listeners.end(), listener) == listeners.end()) {
+        listeners.push_back(listener);
     }
 }
 
-bool Maze::isValid(Point p) const {
-    return p.x >= 0 && p.x < width && p.y >= 0 && p.y < height;
+void Maze::removeListener(IMazeListener* listener) const {
+    if (notifying) std::replace(listeners.begin(), listeners.end(), listener, static_cast<IMazeListener*>(nullptr));
+    else listeners.erase(std::remove(listeners.begin(), listeners.end(), listener), listeners.end());
+}
+
+void Maze::enableConnectivity() {
+    if (connectivity) return;
+    connectivity = std::make_unique<Connectivity>();
+    connectivity->attach(*this);
+}
+
+bool Maze::isConnected(Point a, Point b) {
+    return connectivity && connectivity->connected(a, b);
+}
+
+void Maze::touch() {
+    version = ++lastVersion;
 }
 
-bool Maze::isWall(Point p) const {
-    if (!isValid(p)) return true;
-    return grid[p.y][p.x]->getType() == CellType::WALL;
+void Maze::notifyReset() {
+    touch();
+    notifyListeners([this](IMazeListener* l) { l->onMazeReset(*this); });
+}
+
+void Maze::initializeGrid() {
+    layout = GridLayout(width, height, layout.getKind());
+    cells.assign(layout.size(), CellType::EMPTY);
+    walkable.reset(width, height, true);
+    costs.assign(static_cast<size_t>(width) * height, 1);
+    weightedCells = 0;
+    openCosts.fill(0);
+    openCosts[1] = width * height;
 }
 
 void Maze::setCell(int x, int y, CellType type) {
     if (isValid({ x, y })) {
-        grid[y][x] = Cell::create(type, { x, y });
-        if (type == CellType::START) startPos = { x, y };
-        if (type == CellType::END) endPos = { x, y };
+        CellType oldType = getCell(x, y);
+        std::uint8_t oldCost = getCost(x, y);
+        writeCell(x, y, type);
+        // Rewriting a type still resets a cost set by setCost
+        if (oldType != type || getCost(x, y) != oldCost) {
+            touch();
+            notifyListeners([&](IMazeListener* l) { l->onCellChanged(*this, x, y, oldType); });
+        }
     }
 }
 
+void Maze::writeCell(int x, int y, CellType type) {
+    int i = index(x, y);
+    if (!isWall({ x, y })) openCosts[costs[i]]--;
+    cells[layout.index(x, y)] = type;
+    walkable.set(x, y, type != CellType::WALL);
+    writeCost(i, type == CellType::SPECIAL ? SPECIAL_COST : 1);
+    if (type != CellType::WALL) openCosts[costs[i]]++;
+    if (type == CellType::START) startPos = { x, y };
+    if (type == CellType::END) endPos = { x, y };
+}
+
+void Maze::writeCost(int i, std::uint8_t cost) {
+    weightedCells += (cost > 1) - (costs[i] > 1);
+    costs[i] = cost;
+}
+
+void Maze::setCost(int x, int y, std::uint8_t cost) {
+    if (isWall({ x, y })) return;
+    cost = std::max<std::uint8_t>(cost, 1);
+    if (cost == getCost(x, y)) return;
+    openCosts[getCost(x, y)]--;
+    writeCost(index(x, y), cost);
+    openCosts[cost]++;
+    touch();
+    CellType type = getCell(x, y);
+    notifyListeners([&](IMazeListener* l) { l->onCellChanged(*this, x, y, type); });
+}
+
+int Maze::cheapestCost() const {
+    for (int cost = 1; cost < static_cast<int>(openCosts.size()); ++cost) {
+        if (openCosts[cost] > 0) return cost;
+    }
+    return 1;
+}
+
+void Maze::setCosts(const std::vector<std::uint8_t>& rowMajor) {
+    if (rowMajor.size() != costs.size()) return;
+    for (int y = 0, i = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x, ++i) {
+            if (getCell(x, y) == CellType::WALL) continue;
+            openCosts[costs[i]]--;
+            writeCost(i, std::max<std::uint8_t>(rowMajor[i], 1));
+            openCosts[costs[i]]++;
+        }
+    }
+    notifyReset();
+}
+
 void Maze::loadFromMap(const std::vector<std::string>& layout) {
     height = static_cast<int>(layout.size());
     if (height == 0) return;
     width = static_cast<int>(layout[0].size());
 
-    grid.clear();
-    grid.resize(height);
+    initializeGrid();
 
     for (int y = 0; y < height; ++y) {
-        grid[y].resize(width);
         for (int x = 0; x < width; ++x) {
             char c = layout[y][x];
             CellType t = CellType::EMPTY;
             if (c == '#') t = CellType::WALL;
             else if (c == 'S') t = CellType::START;
             else if (c == 'E') t = CellType::END;
-            setCell(x, y, t);
+            else if (c == '~') t = CellType::SPECIAL;
+            writeCell(x, y, t);
         }
     }
+    notifyReset();
 }
 
 void Maze::resize(int newWidth, int newHeight) {
-    std::vector<std::vector<std::unique_ptr<Cell>>> newGrid;
-    newGrid.resize(newHeight);
-
-    for (int y = 0; y < newHeight; ++y) {
-        newGrid[y].resize(newWidth);
-        for (int x = 0; x < newWidth; ++x) {
-            if (y < height && x < width) {
-                newGrid[y][x] = std::move(grid[y][x]);
-            }
-            else {
-                newGrid[y][x] = Cell::create(CellType::EMPTY, { x, y });
-            }
+    GridLayout newLayout(newWidth, newHeight, layout.getKind());
+    std::vector<CellType> newCells(newLayout.size(), CellType::EMPTY);
+    std::vector<std::uint8_t> newCosts(static_cast<size_t>(newWidth) * newHeight, 1);
+
+    int keepWidth = std::min(width, newWidth);
+    int keepHeight = std::min(height, newHeight);
+    weightedCells = 0;
+    for (int y = 0; y < keepHeight; ++y) {
+        for (int x = 0; x < keepWidth; ++x) {
+            newCells[newLayout.index(x, y)] = getCell(x, y);
+            newCosts[static_cast<size_t>(y) * newWidth + x] = getCost(x, y);
+            weightedCells += getCost(x, y) > 1;
         }
     }
 
-    grid = std::move(newGrid);
+    cells = std::move(newCells);
+    costs = std::move(newCosts);
+    layout = newLayout;
     width = newWidth;
     height = newHeight;
 
+    walkable.reset(width, height);
+    openCosts.fill(0);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (getCell(x, y) == CellType::WALL) continue;
+            walkable.set(x, y, true);
+            openCosts[getCost(x, y)]++;
+        }
+    }
+
     // Update start and end positions if they're out of bounds
     if (startPos.x >= width || startPos.y >= height) {
         startPos = { 0, 0 };
-        setCell(0, 0, CellType::START);
+        writeCell(0, 0, CellType::START);
     }
     if (endPos.x >= width || endPos.y >= height) {
         endPos = { width - 1, height - 1 };
-        setCell(width - 1, height - 1, CellType::END);
+        writeCell(width - 1, height - 1, CellType::END);
     }
+    notifyReset();
+}
+
+OpenNeighbours Maze::openNeighbours(int y, int word) const {
+    OpenNeighbours n;
+    n.self = walkable.word(y, word);
+    n.north = n.self & walkable.word(y - 1, word);
+    n.south = n.self & walkable.word(y + 1, word);
+    // Cell x + 1 sits one bit higher; bit 0 of the next word carries in at the top
+    n.east = n.self & ((n.self >> 1) | (walkable.word(y, word + 1) << 63));
+    n.west = n.self & ((n.self << 1) | (walkable.word(y, word - 1) >> 63));
+    return n;
+}
+
+void Maze::setLayout(CellLayout kind) {
+    if (kind == layout.getKind()) return;
+    GridLayout newLayout(width, height, kind);
+    std::vector<CellType> newCells(newLayout.size(), CellType::EMPTY);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) newCells[newLayout.index(x, y)] = getCell(x, y);
+    }
+    cells = std::move(newCells);
+    layout = newLayout;
+    // Same contents, but anything keyed on storage slots is now stale
+    notifyReset();
 }
 
 void Maze::generateSolvableMaze() {
@@ -95,13 +258,14 @@ std::vector<std::string> Maze::toStringVector() const {
     for (int y = 0; y < height; ++y) {
         std::string row;
         for (int x = 0; x < width; ++x) {
-            CellType t = grid[y][x]->getType();
+            CellType t = getCell(x, y);
             if (t == CellType::WALL) row += '#';
             else if (t == CellType::START) row += 'S';
             else if (t == CellType::END) row += 'E';
+            else if (t == CellType::SPECIAL) row += '~';
             else row += '.';
         }
         result.push_back(row);
     }
     return result;
-}
\ No newline at end of file
+}
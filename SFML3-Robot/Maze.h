@@ -1,22 +1,98 @@
 #pragma once
-#include "Cell.h"
 #include "Enums.h"
+#include "GridBitmap.h"
+#include "GridLayout.h"
 #include "Point.h"
-#include <vector>
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <vector>
 #include <string>
 
+// Open-neighbour masks for 64 consecutive cells of one row: bit i is set when
+// the cell at x = word * 64 + i is open and so is its neighbour on that side.
+struct OpenNeighbours {
+    std::uint64_t self = 0, north = 0, south = 0, east = 0, west = 0;
+};
+
+class Maze;
+class Connectivity;
+
+// Notified after Maze contents change. Listeners are observers only: they are
+// not copied with the maze and are told when the maze goes away.
+class IMazeListener {
+public:
+    // Also sent by setCost, with oldType the cell's unchanged type
+    virtual void onCellChanged(const Maze& maze, int x, int y, CellType oldType) = 0;
+    // Whole-grid changes: loadFromMap, resize, assignment, setCosts
+    virtual void onMazeReset(const Maze& maze) = 0;
+    virtual void onMazeDestroyed(const Maze& maze) = 0;
+    virtual ~IMazeListener() = default;
+};
+
 class Maze {
 public:
+    // Entering an open cell costs 1 unless its cost says otherwise; SPECIAL
+    // terrain starts out at this
+    static constexpr std::uint8_t SPECIAL_COST = 4;
+
     int width = 0, height = 0;
     Point startPos{ 0,0 }, endPos{ 0,0 };
-    std::vector<std::vector<std::unique_ptr<Cell>>> grid;
 
-    Maze() = default;
-    Maze(int w, int h);
+    Maze();
+    Maze(int w, int h, CellLayout kind = CellLayout::ROW_MAJOR);
+    Maze(const Maze& other);
+    Maze& operator=(const Maze& other);
+    ~Maze();
+
+    // Changes whenever the contents do; unique across all mazes, so a cache keyed
+    // on it never mistakes one maze for another
+    std::uint64_t getVersion() const { return version; }
+
+    void addListener(IMazeListener* listener) const;
+    void removeListener(IMazeListener* listener) const;
+
+    // Optional union-find over the open cells, kept in step with setCell. Off by
+    // default and not carried over by copies
+    void enableConnectivity();
+    bool tracksConnectivity() const { return connectivity != nullptr; }
+    // Both cells open and in the same component; only valid while tracking. Not
+    // const: a query may rebuild the sets and compresses paths as it goes
+    bool isConnected(Point a, Point b);
+
+    bool isValid(Point p) const { return p.x >= 0 && p.x < width && p.y >= 0 && p.y < height; }
+    bool isWall(Point p) const { return !isValid(p) || cells[layout.index(p.x, p.y)] == CellType::WALL; }
+    CellType getCell(int x, int y) const { return cells[layout.index(x, y)]; }
+    // Row-major cell id, whatever the storage layout; search buffers are keyed on it
+    int index(int x, int y) const { return y * width + x; }
+    int cellCount() const { return width * height; }
+
+    // Storage order of the cells. Kernels that key their own arrays on storage
+    // slots get the same locality and can step with layout's neighbour offsets.
+    void setLayout(CellLayout kind);
+    const GridLayout& getLayout() const { return layout; }
+    CellType cellAt(int slot) const { return cells[slot]; }
+    bool isWallAt(int slot) const { return cells[slot] == CellType::WALL; }
+
+    // Cost of stepping onto a cell, 1..255, keyed by index(). Read by the weighted
+    // search mode and SearchTask; every other search counts steps
+    int moveCost(int i) const { return costs[i]; }
+    std::uint8_t getCost(int x, int y) const { return costs[index(x, y)]; }
+    // Ignored for walls; 0 is raised to 1. setCell resets the cost to the type's default
+    void setCost(int x, int y, std::uint8_t cost);
+    const std::vector<std::uint8_t>& getCosts() const { return costs; }
+    // Row-major, one per cell; a size mismatch leaves the costs alone
+    void setCosts(const std::vector<std::uint8_t>& rowMajor);
+    // Some open cell costs more than 1
+    bool isWeighted() const { return weightedCells > 0; }
+    // Cost of the cheapest open cell, 1 when there is none. Every step costs at
+    // least this much, so step-counting heuristics may be scaled by it
+    int cheapestCost() const;
+
+    const GridBitmap& getWalkable() const { return walkable; }
+    std::uint64_t openWord(int y, int word) const { return walkable.word(y, word); }
+    OpenNeighbours openNeighbours(int y, int word) const;
 
-    bool isValid(Point p) const;
-    bool isWall(Point p) const;
     void setCell(int x, int y, CellType type);
     void loadFromMap(const std::vector<std::string>& layout);
     void resize(int newWidth, int newHeight);
@@ -25,5 +101,27 @@ public:
     std::vector<std::string> toStringVector() const;
 
 private:
+    // One byte per cell in layout order; start/end live in startPos/endPos
+    std::vector<CellType> cells;
+    GridLayout layout;
+    // Mirror of cells: bit set when the cell is not a wall
+    GridBitmap walkable;
+    // Row-major whatever the layout, like the search buffers that read it
+    std::vector<std::uint8_t> costs;
+    int weightedCells = 0;
+    // Open cells per cost
+    std::array<int, 256> openCosts{};
+    // Entries removed during a notification are nulled and dropped after it
+    mutable std::vector<IMazeListener*> listeners;
+    mutable int notifying = 0;
+    std::uint64_t version = 0;
+    std::unique_ptr<Connectivity> connectivity;
+
     void initializeGrid();
-};
\ No newline at end of file
+    void writeCell(int x, int y, CellType type);
+    void writeCost(int i, std::uint8_t cost);
+    void notifyReset();
+    void touch();
+    template <typename Notify>
+    void notifyListeners(Notify&& notify) const;
+};
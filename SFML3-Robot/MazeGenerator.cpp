@@ -1,4 +1,5 @@
 #include "MazeGenerator.h"
+#include "FloodFill.h"
 #include "Maze.h"
 #include "Point.h"
 #include <vector>
@@ -11,6 +12,7 @@ void MazeGenerator::generateSolvableMaze(Maze* maze) {
     // Set start and end positions
     maze->setCell(1, 1, CellType::START);
     maze->setCell(maze->width - 2, maze->height - 2, CellType::END);
+    connectDeadRegions(maze);
 }
 
 void MazeGenerator::initializeWithWalls(Maze* maze) {
@@ -67,4 +69,37 @@ void MazeGenerator::carvePaths(Maze* maze) {
             stack.pop_back();
         }
     }
+}
+
+int MazeGenerator::connectDeadRegions(Maze* maze) {
+    FloodFill flood;
+    GridBitmap reached, dead;
+    const Point directions[4] = { {0, -1}, {1, 0}, {0, 1}, {-1, 0} };
+    int opened = 0;
+
+    while (true) {
+        const GridBitmap& open = maze->getWalkable();
+        flood.run(open, maze->startPos, reached);
+        dead.reset(maze->width, maze->height);
+        for (int y = 0; y < maze->height; ++y) {
+            for (int w = 0; w < dead.getWordsPerRow(); ++w) dead.row(y)[w] = open.row(y)[w] & ~reached.row(y)[w];
+        }
+
+        // A wall with a dead cell on one side and a reached cell on another
+        Point bridge = { -1, -1 };
+        for (Point p : dead) {
+            for (Point dir : directions) {
+                Point wall = { p.x + dir.x, p.y + dir.y };
+                if (!maze->isValid(wall) || !maze->isWall(wall)) continue;
+                for (Point next : directions) {
+                    if (reached.contains({ wall.x + next.x, wall.y + next.y })) bridge = wall;
+                }
+                if (bridge.x >= 0) break;
+            }
+            if (bridge.x >= 0) break;
+        }
+        if (bridge.x < 0) return opened;
+        maze->setCell(bridge.x, bridge.y, CellType::EMPTY);
+        opened++;
+    }
 }
\ No newline at end of file
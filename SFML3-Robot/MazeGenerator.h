@@ -11,4 +11,8 @@ public:
 private:
     static void initializeWithWalls(Maze* maze);
     static void carvePaths(Maze* maze);
+    // Carving only reaches odd cells, so with an even width or height the end
+    // can land in a pocket of its own. Opens a wall between the start's region
+    // and each such pocket; returns the number of walls opened
+    static int connectDeadRegions(Maze* maze);
 };
\ No newline at end of file
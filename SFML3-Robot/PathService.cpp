@@ -0,0 +1,46 @@
+#include "PathService.h"
+#include <algorithm>
+#include <atomic>
+
+namespace {
+    // Queries are handed out in small chunks: big enough to keep the shared
+    // counter cold, small enough to balance long and short searches
+    const size_t CHUNK = 16;
+}
+
+PathService::PathService(int threadCount) : pool(threadCount) {
+    for (int i = 0; i < pool.size(); ++i) {
+        finders.push_back(std::make_unique<PathFinder>());
+        finders.back()->setMode(mode);
+    }
+}
+
+bool PathService::setMode(SearchMode m) {
+    if (m == SearchMode::JPS_PLUS || m == SearchMode::LPA_STAR) return false;
+    mode = m;
+    for (auto& finder : finders) finder->setMode(m);
+    return true;
+}
+
+void PathService::setHeuristic(HeuristicKind kind) {
+    for (auto& finder : finders) finder->setHeuristic(kind);
+}
+
+void PathService::solve(const Maze& maze, const PathQuery* queries, size_t count, std::vector<PathResult>& results) {
+    results.resize(count);
+    std::atomic<size_t> next{ 0 };
+
+    pool.run([&](int worker) {
+        PathFinder& finder = *finders[worker];
+        while (true) {
+            size_t first = next.fetch_add(CHUNK, std::memory_order_relaxed);
+            if (first >= count) break;
+            size_t last = std::min(count, first + CHUNK);
+            for (size_t i = first; i < last; ++i) {
+                PathResult& result = results[i];
+                result.found = finder.findPath(maze, queries[i].start, queries[i].goal, result.path);
+                result.stats = finder.getStats();
+            }
+        }
+    });
+}
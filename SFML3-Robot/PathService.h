@@ -0,0 +1,45 @@
+#pragma once
+#include "AStar.h"
+#include "Maze.h"
+#include "Point.h"
+#include "ThreadPool.h"
+#include <memory>
+#include <vector>
+
+struct PathQuery {
+    Point start;
+    Point goal;
+};
+
+struct PathResult {
+    bool found = false;
+    std::vector<Point> path;
+    SearchStats stats;
+};
+
+// Answers many start/goal pairs against one maze on a fixed pool of threads.
+// Every worker owns a PathFinder, so search buffers are reused across queries and
+// batches. The maze is only read during solve() and must not change meanwhile.
+class PathService {
+public:
+    explicit PathService(int threadCount = 0);
+
+    // Only modes that keep no maze-attached state can run concurrently; returns
+    // false and leaves the mode unchanged for JPS_PLUS and LPA_STAR
+    bool setMode(SearchMode mode);
+    SearchMode getMode() const { return mode; }
+    void setHeuristic(HeuristicKind kind);
+    int getThreadCount() const { return pool.size(); }
+
+    // results[i] answers queries[i]; reusing the same results vector across
+    // batches keeps its path storage
+    void solve(const Maze& maze, const PathQuery* queries, size_t count, std::vector<PathResult>& results);
+    void solve(const Maze& maze, const std::vector<PathQuery>& queries, std::vector<PathResult>& results) {
+        solve(maze, queries.data(), queries.size(), results);
+    }
+
+private:
+    ThreadPool pool;
+    std::vector<std::unique_ptr<PathFinder>> finders;
+    SearchMode mode = SearchMode::BUCKET_ASTAR;
+};
@@ -0,0 +1,94 @@
+#include "PathWorker.h"
+#include <utility>
+
+PathWorker::PathWorker() : thread(&PathWorker::loop, this) {
+}
+
+PathWorker::~PathWorker() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        hasPending = false;
+    }
+    latestJob++;
+    wake.notify_one();
+    thread.join();
+    delete mailbox.exchange(nullptr);
+}
+
+std::uint64_t PathWorker::submit(const Maze& maze, Point from, Point goal) {
+    return submit(std::make_shared<const Maze>(maze), from, goal);
+}
+
+std::uint64_t PathWorker::submit(std::shared_ptr<const Maze> snapshot, Point from, Point goal) {
+    std::uint64_t id;
+    Job superseded;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // Bumping the id is what tells a running search it has been superseded
+        id = ++latestJob;
+        superseded = std::move(pending);
+        pending = { std::move(snapshot), from, goal, id };
+        hasPending = true;
+    }
+    wake.notify_one();
+    return id;
+}
+
+void PathWorker::cancel() {
+    std::shared_ptr<const Maze> dropped;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        dropped = std::move(pending.maze);
+        hasPending = false;
+        finishedJob = ++latestJob;
+    }
+}
+
+std::unique_ptr<PathJobResult> PathWorker::poll() {
+    std::unique_ptr<PathJobResult> result(mailbox.exchange(nullptr, std::memory_order_acquire));
+    // A result that raced with a newer submit is of no use to the caller
+    if (result && result->job != latestJob.load()) result.reset();
+    return result;
+}
+
+void PathWorker::loop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || hasPending; });
+            if (stopping) return;
+            job = std::move(pending);
+            hasPending = false;
+        }
+        run(job);
+    }
+}
+
+void PathWorker::run(const Job& job) {
+    progress.store(0.0f, std::memory_order_relaxed);
+    task.start(*job.maze, job.from, job.goal);
+    while (!task.step(SLICE_NODES)) {
+        if (latestJob.load(std::memory_order_relaxed) != job.id) {
+            task.cancel();
+            return;
+        }
+        progress.store(task.getProgress(), std::memory_order_relaxed);
+    }
+    progress.store(1.0f, std::memory_order_relaxed);
+
+    PathJobResult* result = new PathJobResult();
+    result->job = job.id;
+    result->from = job.from;
+    result->goal = job.goal;
+    result->status = task.getStatus();
+    result->path = task.getPath();
+    result->explored = task.getExplored();
+    result->expanded = task.getExpanded();
+    // An unclaimed older result is overwritten; only the newest one matters
+    delete mailbox.exchange(result, std::memory_order_release);
+    std::uint64_t expected = finishedJob.load();
+    while (expected < job.id && !finishedJob.compare_exchange_weak(expected, job.id)) {
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include "CompactPath.h"
+#include "Enums.h"
+#include "GridBitmap.h"
+#include "Maze.h"
+#include "Point.h"
+#include "SearchTask.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+struct PathJobResult {
+    std::uint64_t job = 0;
+    Point from{ 0,0 }, goal{ 0,0 };
+    SearchStatus status = SearchStatus::IDLE;
+    CompactPath path;
+    GridBitmap explored;
+    int expanded = 0;
+};
+
+// One background thread that searches private snapshots of a maze. Only the
+// newest job matters: submitting supersedes whatever is queued or running, and
+// the running search checks between slices whether it is still wanted. Results
+// come back through a single-slot mailbox (an atomic pointer swap), so polling
+// it from the frame loop never blocks.
+class PathWorker {
+public:
+    PathWorker();
+    PathWorker(const PathWorker&) = delete;
+    PathWorker& operator=(const PathWorker&) = delete;
+    ~PathWorker();
+
+    // Copies the maze; returns the new job's id
+    std::uint64_t submit(const Maze& maze, Point from, Point goal);
+    std::uint64_t submit(std::shared_ptr<const Maze> snapshot, Point from, Point goal);
+    // Drops the queued job and stops the running one at its next check
+    void cancel();
+
+    // The newest job's result once it is ready, otherwise null
+    std::unique_ptr<PathJobResult> poll();
+    bool isBusy() const { return finishedJob.load() != latestJob.load(); }
+    // Of the job being searched, 0..1
+    float getProgress() const { return progress.load(std::memory_order_relaxed); }
+
+private:
+    // Nodes between cancellation checks
+    static constexpr int SLICE_NODES = 4096;
+
+    struct Job {
+        std::shared_ptr<const Maze> maze;
+        Point from{ 0,0 }, goal{ 0,0 };
+        std::uint64_t id = 0;
+    };
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    Job pending;
+    bool hasPending = false;
+    bool stopping = false;
+
+    std::atomic<std::uint64_t> latestJob{ 0 };
+    // Id of the newest job that was answered or abandoned
+    std::atomic<std::uint64_t> finishedJob{ 0 };
+    std::atomic<PathJobResult*> mailbox{ nullptr };
+    std::atomic<float> progress{ 0.0f };
+
+    // Worker thread only
+    SearchTask task;
+    std::thread thread;
+
+    void loop();
+    void run(const Job& job);
+};
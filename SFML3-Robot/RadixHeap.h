@@ -0,0 +1,88 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Monotone integer priority queue for keys that spread too far for one bucket
+// per key, such as A* over weighted cells. Bucket b holds the keys whose
+// highest bit differing from the last popped key is bit b - 1; popping from an
+// empty bucket 0 redistributes the smallest non-empty bucket, so each entry
+// moves at most 32 times. Keys must never drop below the last popped key.
+template <typename T>
+class RadixHeap {
+private:
+    static constexpr int BUCKETS = 33;
+
+    std::vector<std::pair<std::uint32_t, T>> buckets[BUCKETS];
+    std::uint32_t last = 0;
+    size_t count = 0;
+
+    static int highestBit(std::uint64_t w) {
+#if defined(_MSC_VER)
+        unsigned long i;
+        _BitScanReverse64(&i, w);
+        return static_cast<int>(i);
+#else
+        return 63 - __builtin_clzll(w);
+#endif
+    }
+    // Without a branch: equal keys are about as common as unequal ones in A*, and
+    // the low bit keeps the scan defined when they are equal
+    int bucketOf(std::uint32_t key) const { return highestBit((static_cast<std::uint64_t>(key ^ last) << 1) | 1); }
+
+    // Makes bucket 0 hold the smallest key
+    void settle() {
+        if (!buckets[0].empty()) return;
+        int b = 1;
+        while (buckets[b].empty()) b++;
+        std::uint32_t smallest = buckets[b].front().first;
+        bool sameKey = true;
+        for (const auto& entry : buckets[b]) {
+            sameKey &= entry.first == smallest;
+            smallest = entry.first < smallest ? entry.first : smallest;
+        }
+        last = smallest;
+        if (sameKey) {
+            // Common when steps are cheap: the whole bucket becomes bucket 0 as it is
+            buckets[0].swap(buckets[b]);
+            return;
+        }
+        // Every entry lands in a lower bucket, so b is not refilled while being emptied
+        for (auto& entry : buckets[b]) buckets[bucketOf(entry.first)].push_back(std::move(entry));
+        buckets[b].clear();
+    }
+
+public:
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    void push(int key, const T& value) {
+        std::uint32_t k = static_cast<std::uint32_t>(key);
+        buckets[bucketOf(k)].push_back({ k, value });
+        count++;
+    }
+
+    T pop() {
+        settle();
+        T value = buckets[0].back().second;
+        buckets[0].pop_back();
+        count--;
+        return value;
+    }
+
+    int topKey() {
+        settle();
+        return static_cast<int>(last);
+    }
+
+    // Keeps the bucket storage for the next search
+    void clear() {
+        for (auto& bucket : buckets) bucket.clear();
+        last = 0;
+        count = 0;
+    }
+};
@@ -0,0 +1,84 @@
+#include "ReachabilityEngine.h"
+#include <algorithm>
+
+namespace {
+    // Below this many cells a level is cheaper to expand than to hand to the pool
+    const size_t PARALLEL_FRONTIER = 4096;
+    const size_t CHUNK = 1024;
+}
+
+ReachabilityEngine::ReachabilityEngine(int threadCount) : pool(threadCount) {
+    nextFrontiers.resize(pool.size());
+}
+
+void ReachabilityEngine::prepare(const Maze& maze) {
+    const GridBitmap& walkable = maze.getWalkable();
+    wordsPerRow = walkable.getWordsPerRow();
+    size_t words = static_cast<size_t>(wordsPerRow) * maze.height;
+    if (words != visitedWords) {
+        visited.reset(new std::atomic<std::uint64_t>[words]);
+        visitedWords = words;
+    }
+    // Walls and the row padding start out claimed, so expansion needs no wall test
+    for (int y = 0; y < maze.height; ++y) {
+        const std::uint64_t* row = walkable.row(y);
+        for (int w = 0; w < wordsPerRow; ++w) {
+            visited[static_cast<size_t>(y) * wordsPerRow + w].store(~row[w], std::memory_order_relaxed);
+        }
+    }
+}
+
+template <bool Shared>
+bool ReachabilityEngine::expand(const Maze& maze, size_t first, size_t last, Point target, std::vector<Point>& out) {
+    bool found = false;
+    auto visit = [&](Point n) {
+        out.push_back(n);
+        found |= n == target;
+    };
+    for (size_t k = first; k < last; ++k) {
+        Point p = frontier[k];
+        if (p.y + 1 < maze.height && claim<Shared>(p.x, p.y + 1)) visit({ p.x, p.y + 1 });
+        if (p.y > 0 && claim<Shared>(p.x, p.y - 1)) visit({ p.x, p.y - 1 });
+        if (p.x + 1 < maze.width && claim<Shared>(p.x + 1, p.y)) visit({ p.x + 1, p.y });
+        if (p.x > 0 && claim<Shared>(p.x - 1, p.y)) visit({ p.x - 1, p.y });
+    }
+    return found;
+}
+
+int ReachabilityEngine::distance(const Maze& maze, Point from, Point to) {
+    if (maze.isWall(from) || maze.isWall(to)) return -1;
+    if (from == to) return 0;
+
+    prepare(maze);
+    claim<false>(from.x, from.y);
+    frontier.assign(1, from);
+
+    for (int level = 1; !frontier.empty(); ++level) {
+        bool found = false;
+        if (frontier.size() < PARALLEL_FRONTIER || pool.size() == 1) {
+            std::vector<Point>& next = nextFrontiers[0];
+            next.clear();
+            found = expand<false>(maze, 0, frontier.size(), to, next);
+            std::swap(frontier, next);
+        }
+        else {
+            std::atomic<size_t> nextChunk{ 0 };
+            std::atomic<bool> hit{ false };
+            pool.run([&](int worker) {
+                std::vector<Point>& out = nextFrontiers[worker];
+                out.clear();
+                while (true) {
+                    size_t first = nextChunk.fetch_add(CHUNK, std::memory_order_relaxed);
+                    if (first >= frontier.size()) break;
+                    size_t last = std::min(frontier.size(), first + CHUNK);
+                    if (expand<true>(maze, first, last, to, out)) hit = true;
+                }
+            });
+            found = hit;
+            frontier.clear();
+            for (const auto& part : nextFrontiers) frontier.insert(frontier.end(), part.begin(), part.end());
+        }
+        if (found) return level;
+    }
+    return -1;
+}
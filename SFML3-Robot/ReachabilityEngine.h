@@ -0,0 +1,54 @@
+#pragma once
+#include "Maze.h"
+#include "Point.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Yes/no reachability with the BFS distance as a by-product. The search is
+// level-synchronous: every level's frontier is split across the pool and
+// cells are claimed with an atomic test-and-set on a visited bitmap that
+// starts out as the maze's walls, so no parents or per-cell costs are stored.
+// Small frontiers are expanded on the calling thread.
+class ReachabilityEngine {
+public:
+    // 0 picks std::thread::hardware_concurrency()
+    explicit ReachabilityEngine(int threadCount = 0);
+    ReachabilityEngine(const ReachabilityEngine&) = delete;
+    ReachabilityEngine& operator=(const ReachabilityEngine&) = delete;
+
+    // Steps from one cell to the other, -1 when there is no path
+    int distance(const Maze& maze, Point from, Point to);
+    bool isReachable(const Maze& maze, Point from, Point to) { return distance(maze, from, to) >= 0; }
+
+    int getThreadCount() const { return pool.size(); }
+
+private:
+    ThreadPool pool;
+    // Row-padded like GridBitmap; a set bit means wall or already claimed
+    std::unique_ptr<std::atomic<std::uint64_t>[]> visited;
+    size_t visitedWords = 0;
+    int wordsPerRow = 0;
+    std::vector<Point> frontier;
+    std::vector<std::vector<Point>> nextFrontiers;
+
+    void prepare(const Maze& maze);
+    // Only a shared level pays for the locked read-modify-write
+    template <bool Shared>
+    bool claim(int x, int y) {
+        std::atomic<std::uint64_t>& word = visited[static_cast<size_t>(y) * wordsPerRow + (x >> 6)];
+        std::uint64_t bit = std::uint64_t(1) << (x & 63);
+        std::uint64_t old = word.load(std::memory_order_relaxed);
+        if (old & bit) return false;
+        if (!Shared) {
+            word.store(old | bit, std::memory_order_relaxed);
+            return true;
+        }
+        return !(word.fetch_or(bit, std::memory_order_relaxed) & bit);
+    }
+    // Expands frontier[first, last) into out; true if target was claimed
+    template <bool Shared>
+    bool expand(const Maze& maze, size_t first, size_t last, Point target, std::vector<Point>& out);
+};
@@ -0,0 +1,76 @@
+#include "ReservationTable.h"
+#include <utility>
+
+namespace {
+    const size_t INITIAL_SLOTS = 1024;
+}
+
+ReservationTable::ReservationTable() {
+    rebuild(INITIAL_SLOTS);
+}
+
+size_t ReservationTable::find(std::uint64_t key) const {
+    // Fibonacci hashing spreads the consecutive cells and times of a path
+    size_t i = static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+    while (slots[i].key != key && slots[i].key != EMPTY) i = (i + 1) & mask;
+    return i;
+}
+
+int ReservationTable::holder(int cell, int time) const {
+    const Slot& s = slots[find(keyOf(cell, time))];
+    return s.key == EMPTY ? NONE : s.agent;
+}
+
+bool ReservationTable::isSwap(int from, int to, int time, int agent) const {
+    int other = holder(to, time);
+    return other != NONE && other != agent && holder(from, time + 1) == other;
+}
+
+int ReservationTable::reserve(int cell, int time, int agent) {
+    // Keeps the probe chains short: at most half the slots ever hold a key
+    if ((used + 1) * 2 > slots.size()) rebuild(live * 4 > slots.size() ? slots.size() * 2 : slots.size());
+    std::uint64_t key = keyOf(cell, time);
+    Slot& s = slots[find(key)];
+    int previous = NONE;
+    if (s.key == EMPTY) {
+        s.key = key;
+        used++;
+        live++;
+    }
+    else if (s.agent == NONE) {
+        live++;
+    }
+    else {
+        previous = s.agent;
+    }
+    s.agent = agent;
+    return previous;
+}
+
+void ReservationTable::release(int cell, int time, int agent) {
+    Slot& s = slots[find(keyOf(cell, time))];
+    if (s.key == EMPTY || s.agent != agent) return;
+    s.agent = NONE;
+    live--;
+}
+
+void ReservationTable::clear() {
+    for (Slot& s : slots) s = { EMPTY, NONE };
+    used = 0;
+    live = 0;
+}
+
+void ReservationTable::rebuild(size_t capacity) {
+    std::vector<Slot> old(capacity, Slot{ EMPTY, NONE });
+    old.swap(slots);
+    mask = capacity - 1;
+    used = 0;
+    live = 0;
+    for (const Slot& s : old) {
+        if (s.key == EMPTY || s.agent == NONE || static_cast<int>(s.key >> 32) < now) continue;
+        Slot& to = slots[find(s.key)];
+        to = s;
+        used++;
+        live++;
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Which agent holds a cell at a time step, for cooperative planning. Open
+// addressing over (time, cell) keys; releasing an entry keeps its key so probe
+// chains stay intact, and entries behind the current time are dropped whenever
+// the table is rebuilt to make room.
+class ReservationTable {
+public:
+    static constexpr int NONE = -1;
+
+    ReservationTable();
+
+    // Drops everything earlier than time at the next rebuild
+    void setTime(int time) { now = time; }
+    int getTime() const { return now; }
+
+    // NONE when free
+    int holder(int cell, int time) const;
+    bool isFree(int cell, int time, int agent) const {
+        int h = holder(cell, time);
+        return h == NONE || h == agent;
+    }
+    // Moving from -> to between time and time + 1 would swap places with another agent
+    bool isSwap(int from, int to, int time, int agent) const;
+
+    // Returns the previous holder, NONE if there was none
+    int reserve(int cell, int time, int agent);
+    void release(int cell, int time, int agent);
+    void clear();
+
+    size_t size() const { return live; }
+    size_t memoryBytes() const { return slots.capacity() * sizeof(Slot); }
+
+private:
+    struct Slot {
+        std::uint64_t key;
+        std::int32_t agent;
+    };
+    static constexpr std::uint64_t EMPTY = ~std::uint64_t(0);
+
+    std::vector<Slot> slots;
+    std::uint64_t mask = 0;
+    // Slots with a key, released ones included
+    size_t used = 0;
+    size_t live = 0;
+    int now = 0;
+
+    static std::uint64_t keyOf(int cell, int time) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(time)) << 32) | static_cast<std::uint32_t>(cell);
+    }
+    size_t find(std::uint64_t key) const;
+    void rebuild(size_t capacity);
+};
@@ -1,4 +1,5 @@
 #include "Robot.h"
+#include "FlowField.h"
 
 void Robot::setPosition(Point p) {
     gridPos = p;
@@ -17,6 +18,20 @@ void Robot::moveTo(Point next) {
     stepCount++;
 }
 
+bool Robot::advance(CompactPath::const_iterator& cursor, const CompactPath::const_iterator& end) {
+    if (moving || cursor == end) return false;
+    moveTo(*cursor);
+    ++cursor;
+    return true;
+}
+
+bool Robot::advance(const FlowField& field) {
+    Point next;
+    if (moving || !field.nextStep(gridPos, next)) return false;
+    moveTo(next);
+    return true;
+}
+
 void Robot::update(float dt) {
     if (state == RobotState::PAUSED) return;
     if (!moving) return;
@@ -1,8 +1,11 @@
 #pragma once
+#include "CompactPath.h"
 #include "Enums.h"
 #include "Point.h"
 #include <SFML/Graphics.hpp>
 
+class FlowField;
+
 class Robot {
 private:
     float fx = 0.0f, fy = 0.0f;
@@ -26,6 +29,12 @@ public:
     float getMoveDuration() const { return moveDuration; }
 
     void moveTo(Point next);
+    // Starts the move to the cursor's cell and advances the cursor; false while
+    // still moving or once the cursor reaches end
+    bool advance(CompactPath::const_iterator& cursor, const CompactPath::const_iterator& end);
+    // Starts the move to the field's next step from the robot's cell; false while
+    // still moving, at the field's goal or where the goal is out of reach
+    bool advance(const FlowField& field);
     void update(float dt);
     void pause();
     void resume();
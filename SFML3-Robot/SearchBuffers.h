@@ -0,0 +1,36 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Per-cell search state keyed by Maze::index. Entries are only valid when their
+// stamp equals the current generation, so starting a new search is O(1) instead
+// of clearing every array; memory is only touched again when the maze size changes.
+struct SearchBuffers {
+    std::vector<int> gCost;
+    std::vector<int> parent;
+    std::vector<std::uint32_t> seen;
+    std::vector<std::uint32_t> closed;
+    std::uint32_t generation = 0;
+
+    void prepare(int cellCount) {
+        if (static_cast<int>(gCost.size()) != cellCount) {
+            gCost.assign(cellCount, 0);
+            parent.assign(cellCount, -1);
+            seen.assign(cellCount, 0);
+            closed.assign(cellCount, 0);
+            generation = 0;
+        }
+        if (++generation == 0) {
+            // Stamps wrapped around: old entries could alias the new generation
+            std::fill(seen.begin(), seen.end(), 0);
+            std::fill(closed.begin(), closed.end(), 0);
+            generation = 1;
+        }
+    }
+
+    bool isSeen(int i) const { return seen[i] == generation; }
+    bool isClosed(int i) const { return closed[i] == generation; }
+    void open(int i, int g, int from) { gCost[i] = g; parent[i] = from; seen[i] = generation; }
+    void close(int i) { closed[i] = generation; }
+};
@@ -0,0 +1,175 @@
+#include "SearchTask.h"
+#include "Heuristics.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+    // Zeroing memory and following parents are far cheaper than an expansion,
+    // so one unit of budget covers this many cells of either
+    const int CELLS_PER_NODE = 64;
+    const Point STEPS[4] = { {0,1},{0,-1},{1,0},{-1,0} };
+}
+
+void SearchTask::start(const Maze& m, Point start, Point target) {
+    maze = &m;
+    from = start;
+    goal = target;
+    expanded = 0;
+    clearOpen();
+    path.clear();
+    if (!m.isValid(from) || !m.isValid(goal) || m.isWall(from) || m.isWall(goal)) {
+        closed.reset(m.width, m.height);
+        finish(SearchStatus::NO_PATH);
+        return;
+    }
+    layout = m.getLayout();
+    // Only growing needs the sliced preparation; smaller mazes reuse the arrays as they are
+    if (seen.size() < layout.size()) {
+        gCost.reserve(layout.size());
+        seen.reserve(layout.size());
+        arrivedBy.reserve(layout.size());
+        status = SearchStatus::PREPARING;
+        return;
+    }
+    begin();
+}
+
+void SearchTask::cancel() {
+    if (isRunning()) finish(SearchStatus::CANCELLED);
+}
+
+int SearchTask::prepare(int budget) {
+    size_t target = layout.size();
+    size_t size = std::min(target, seen.size() + static_cast<size_t>(budget) * CELLS_PER_NODE);
+    gCost.resize(size);
+    seen.resize(size);
+    arrivedBy.resize(size);
+    if (size == target) begin();
+    return budget;
+}
+
+void SearchTask::begin() {
+    if (++generation == 0) {
+        // Stamps wrapped around: old entries could alias the new generation
+        std::fill(seen.begin(), seen.end(), 0);
+        generation = 1;
+    }
+    closed.reset(maze->width, maze->height);
+    weighted = maze->isWeighted();
+    scale = maze->cheapestCost();
+    startDistance = bestDistance = ManhattanDistance{}(from, goal);
+    int startIndex = layout.index(from.x, from.y);
+    gCost[startIndex] = 0;
+    seen[startIndex] = generation;
+    openKey = startDistance * scale;
+    push(openKey, { 0, startIndex });
+    status = SearchStatus::RUNNING;
+}
+
+void SearchTask::push(int key, OpenNode node) {
+    open[key & (RING - 1)].push_back(node);
+    openCount++;
+}
+
+void SearchTask::clearOpen() {
+    for (auto& bucket : open) bucket.clear();
+    openCount = 0;
+}
+
+int SearchTask::expand(int budget) {
+    const Maze& m = *maze;
+    int goalIndex = layout.index(goal.x, goal.y);
+    int offsets[4];
+    int done = 0;
+    while (done < budget) {
+        if (openCount == 0) {
+            finish(SearchStatus::NO_PATH);
+            break;
+        }
+        while (open[openKey & (RING - 1)].empty()) openKey++;
+        std::vector<OpenNode>& bucket = open[openKey & (RING - 1)];
+        OpenNode top = bucket.back();
+        bucket.pop_back();
+        openCount--;
+        done++;
+
+        // Entries are only pushed on a strict improvement, so any other g is stale
+        if (top.g != gCost[top.index]) continue;
+        Point p = layout.point(top.index);
+        if (closed.test(p.x, p.y)) continue;
+        closed.set(p.x, p.y, true);
+        expanded++;
+        bestDistance = std::min(bestDistance, ManhattanDistance{}(p, goal));
+        if (top.index == goalIndex) {
+            clearOpen();
+            path.push_back(goal);
+            traceCell = goal;
+            status = SearchStatus::TRACING;
+            break;
+        }
+
+        layout.neighbourOffsets(p.x, p.y, offsets);
+        for (int d = 0; d < 4; ++d) {
+            Point next = { p.x + STEPS[d].x, p.y + STEPS[d].y };
+            if (!m.isValid(next)) continue;
+            int n = top.index + offsets[d];
+            if (m.isWallAt(n)) continue;
+            // Costs are row-major, whatever the layout
+            int g = top.g + (weighted ? m.moveCost(m.index(next.x, next.y)) : 1);
+            if (seen[n] == generation && gCost[n] <= g) continue;
+            gCost[n] = g;
+            seen[n] = generation;
+            arrivedBy[n] = static_cast<std::uint8_t>(d);
+            push(g + ManhattanDistance{}(next, goal) * scale, { g, n });
+        }
+    }
+    return done;
+}
+
+int SearchTask::trace(int budget) {
+    for (int cells = budget * CELLS_PER_NODE; cells > 0 && traceCell != from; --cells) {
+        Point step = STEPS[arrivedBy[layout.index(traceCell.x, traceCell.y)]];
+        traceCell = { traceCell.x - step.x, traceCell.y - step.y };
+        path.push_back(traceCell);
+    }
+    if (traceCell == from) {
+        path.reverse();
+        finish(SearchStatus::FOUND);
+    }
+    return budget;
+}
+
+bool SearchTask::step(int maxNodes) {
+    if (status == SearchStatus::PREPARING) maxNodes -= prepare(std::max(1, maxNodes / 2));
+    if (status == SearchStatus::RUNNING && maxNodes > 0) maxNodes -= expand(maxNodes);
+    if (status == SearchStatus::TRACING && maxNodes > 0) trace(maxNodes);
+    return !isRunning();
+}
+
+bool SearchTask::runFor(double seconds) {
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+    while (!step(CLOCK_STRIDE)) {
+        if (Clock::now() >= deadline) return false;
+    }
+    return true;
+}
+
+float SearchTask::getProgress() const {
+    if (!isRunning()) return 1.0f;
+    if (status == SearchStatus::PREPARING || startDistance == 0) return 0.0f;
+    return 1.0f - static_cast<float>(bestDistance) / startDistance;
+}
+
+size_t SearchTask::memoryBytes() const {
+    size_t openBytes = 0;
+    for (const auto& bucket : open) openBytes += bucket.capacity() * sizeof(OpenNode);
+    return gCost.capacity() * sizeof(int) + seen.capacity() * sizeof(std::uint32_t) +
+        arrivedBy.capacity() + closed.memoryBytes() + openBytes + path.memoryBytes();
+}
+
+void SearchTask::finish(SearchStatus result) {
+    status = result;
+    clearOpen();
+    if (result != SearchStatus::FOUND) path.clear();
+}
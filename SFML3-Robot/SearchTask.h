@@ -0,0 +1,90 @@
+#pragma once
+#include "CompactPath.h"
+#include "Enums.h"
+#include "GridBitmap.h"
+#include "GridLayout.h"
+#include "Maze.h"
+#include "Point.h"
+#include <cstdint>
+#include <vector>
+
+// A* that can stop after any expansion and carry on later, so the render loop
+// can give it a fixed slice of every frame. Everything that grows with the maze
+// or the path is sliced the same way: zeroing bigger per-cell arrays and
+// walking the parents back into a CompactPath. The maze must stay alive and
+// unchanged until the task finishes or is started again.
+class SearchTask {
+public:
+    SearchTask() = default;
+    SearchTask(const SearchTask&) = delete;
+    SearchTask& operator=(const SearchTask&) = delete;
+
+    void start(const Maze& maze, Point from, Point goal);
+    void cancel();
+
+    // Does up to maxNodes expansions, or the same amount of preparation or path
+    // tracing; true once finished
+    bool step(int maxNodes);
+    // Works until finished or the budget is spent; the clock is read every CLOCK_STRIDE nodes
+    bool runFor(double seconds);
+
+    SearchStatus getStatus() const { return status; }
+    bool isRunning() const {
+        return status == SearchStatus::PREPARING || status == SearchStatus::RUNNING || status == SearchStatus::TRACING;
+    }
+    int getExpanded() const { return expanded; }
+    // 0..1, from how close the best expanded cell has come to the goal
+    float getProgress() const;
+    // Cells expanded so far; also the closed set
+    const GridBitmap& getExplored() const { return closed; }
+    Point getStart() const { return from; }
+    Point getGoal() const { return goal; }
+
+    // Start to goal inclusive once the status is FOUND, empty otherwise
+    const CompactPath& getPath() const { return path; }
+    size_t memoryBytes() const;
+
+private:
+    static constexpr int CLOCK_STRIDE = 256;
+    // A step onto a cell of cost c moves the Manhattan distance by one, scaled
+    // by the cheapest cost s <= c, so a push raises f by c - s or c + s. Every
+    // open key then lies within 2 * 255 of the smallest one, and buckets indexed
+    // by key modulo RING are a complete bucket queue that never grows
+    static constexpr int RING = 512;
+
+    struct OpenNode { int g; int index; };
+
+    const Maze* maze = nullptr;
+    Point from{ 0,0 }, goal{ 0,0 };
+    SearchStatus status = SearchStatus::IDLE;
+    int expanded = 0;
+    int startDistance = 0;
+    int bestDistance = 0;
+    // Terrain costs are only read when the maze has some; scale is its cheapest cost
+    bool weighted = false;
+    int scale = 1;
+
+    // Keyed on the maze's storage slots, so a tiled maze keeps them tiled too;
+    // entries are valid where seen matches generation
+    GridLayout layout;
+    std::vector<int> gCost;
+    std::vector<std::uint32_t> seen;
+    // Index into the step table of the move that reached the cell
+    std::vector<std::uint8_t> arrivedBy;
+    std::uint32_t generation = 0;
+    GridBitmap closed;
+    std::vector<OpenNode> open[RING];
+    int openKey = 0;
+    size_t openCount = 0;
+    // Walked back from the goal, then reversed
+    CompactPath path;
+    Point traceCell{ 0,0 };
+
+    int prepare(int budget);
+    void begin();
+    int expand(int budget);
+    int trace(int budget);
+    void push(int key, OpenNode node);
+    void clearOpen();
+    void finish(SearchStatus result);
+};
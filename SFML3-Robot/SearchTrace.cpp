@@ -0,0 +1,16 @@
+#include "SearchTrace.h"
+
+void SearchTrace::begin(int w, int h) {
+    width = w;
+    height = h;
+    count = 0;
+    expansions = 0;
+    next = chunkEnd = nullptr;
+}
+
+void SearchTrace::nextChunk() {
+    size_t index = count / CHUNK_EVENTS;
+    if (index == chunks.size()) chunks.emplace_back(new TraceEvent[CHUNK_EVENTS]);
+    next = chunks[index].get();
+    chunkEnd = next + CHUNK_EVENTS;
+}
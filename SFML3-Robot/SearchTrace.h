@@ -0,0 +1,66 @@
+#pragma once
+#include "Enums.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// One recorded step of a search: a cell index (Maze::index) and its g cost.
+// The top bit of the index word tells expansions from pushes.
+struct TraceEvent {
+    std::uint32_t cellAndType;
+    std::int32_t cost;
+
+    int cell() const { return static_cast<int>(cellAndType & 0x7FFFFFFFu); }
+    int getCost() const { return cost; }
+    TraceEventType type() const { return (cellAndType >> 31) ? TraceEventType::EXPAND : TraceEventType::PUSH; }
+};
+
+// Append-only event log of one search, for replaying it after the fact. Events
+// go into fixed-size chunks that are never moved, and the chunks are kept
+// between recordings, so a warmed-up trace records without allocating.
+class SearchTrace {
+public:
+    static constexpr size_t CHUNK_EVENTS = 4096;
+
+    SearchTrace() = default;
+    SearchTrace(const SearchTrace&) = delete;
+    SearchTrace& operator=(const SearchTrace&) = delete;
+
+    // Drops the previous recording; the grid size turns cell indices back into points
+    void begin(int width, int height);
+
+    void push(int cell, int cost) { append(static_cast<std::uint32_t>(cell), cost); }
+    void expand(int cell, int cost) { append(static_cast<std::uint32_t>(cell) | 0x80000000u, cost); }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const TraceEvent& operator[](size_t i) const { return chunks[i / CHUNK_EVENTS][i % CHUNK_EVENTS]; }
+    size_t expandedCount() const { return expansions; }
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    size_t memoryBytes() const { return chunks.size() * CHUNK_EVENTS * sizeof(TraceEvent); }
+
+private:
+    std::vector<std::unique_ptr<TraceEvent[]>> chunks;
+    TraceEvent* next = nullptr;
+    TraceEvent* chunkEnd = nullptr;
+    size_t count = 0;
+    size_t expansions = 0;
+    int width = 0, height = 0;
+
+    void append(std::uint32_t cellAndType, int cost) {
+        if (next == chunkEnd) nextChunk();
+        *next++ = { cellAndType, cost };
+        count++;
+        expansions += cellAndType >> 31;
+    }
+    void nextChunk();
+};
+
+// Stand-in recorder for searches without a trace; the calls compile to nothing
+struct NoTrace {
+    void push(int, int) {}
+    void expand(int, int) {}
+};
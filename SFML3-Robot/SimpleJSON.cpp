@@ -1,13 +1,114 @@
 #include "SimpleJSON.h"
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
 #include <sstream>
 #include <string>
 
+namespace {
+    // Cursor over the text; every read reports whether it found what it expected
+    struct Reader {
+        const std::string& text;
+        size_t pos = 0;
+
+        void skipSpace() {
+            while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) pos++;
+        }
+        bool consume(char c) {
+            skipSpace();
+            if (pos >= text.size() || text[pos] != c) return false;
+            pos++;
+            return true;
+        }
+        bool peek(char c) {
+            skipSpace();
+            return pos < text.size() && text[pos] == c;
+        }
+
+        bool readString(std::string& out) {
+            out.clear();
+            if (!consume('"')) return false;
+            while (pos < text.size()) {
+                char c = text[pos++];
+                if (c == '"') return true;
+                if (c == '\\') {
+                    if (pos >= text.size()) return false;
+                    c = text[pos++];
+                    if (c == 'n') c = '\n';
+                    else if (c == 't') c = '\t';
+                }
+                out += c;
+            }
+            return false;
+        }
+
+        bool readInt(int& out) {
+            skipSpace();
+            size_t begin = pos;
+            if (pos < text.size() && text[pos] == '-') pos++;
+            while (pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos]))) pos++;
+            if (pos == begin || text[pos - 1] == '-') return false;
+            // Unlike stoi, strtol reports a number out of range instead of throwing
+            errno = 0;
+            long value = std::strtol(text.c_str() + begin, nullptr, 10);
+            if (errno == ERANGE || value < INT_MIN || value > INT_MAX) return false;
+            out = static_cast<int>(value);
+            return true;
+        }
+
+        // Calls item once per element; it must read exactly one value
+        template <typename Item>
+        bool readArray(Item item) {
+            if (!consume('[')) return false;
+            if (consume(']')) return true;
+            do {
+                if (!item()) return false;
+            } while (consume(','));
+            return consume(']');
+        }
+
+        bool skipValue() {
+            if (peek('"')) {
+                std::string ignored;
+                return readString(ignored);
+            }
+            if (peek('[')) return readArray([this] { return skipValue(); });
+            if (consume('{')) {
+                if (consume('}')) return true;
+                do {
+                    std::string key;
+                    if (!readString(key) || !consume(':') || !skipValue()) return false;
+                } while (consume(','));
+                return consume('}');
+            }
+            // Numbers and the literals true, false and null
+            size_t begin = pos;
+            while (pos < text.size() && (std::isalnum(static_cast<unsigned char>(text[pos])) ||
+                text[pos] == '-' || text[pos] == '+' || text[pos] == '.')) pos++;
+            return pos > begin;
+        }
+    };
+
+    void writeString(std::stringstream& json, const std::string& s) {
+        json << '"';
+        for (char c : s) {
+            if (c == '"' || c == '\\') json << '\\';
+            json << c;
+        }
+        json << '"';
+    }
+}
+
 std::string SimpleJSON::stringify(const std::vector<std::string>& maze,
     const std::string& name,
-    int width, int height) {
+    int width, int height,
+    const std::vector<std::uint8_t>& costs) {
     std::stringstream json;
     json << "{\n";
-    json << "  \"name\": \"" << name << "\",\n";
+    json << "  \"name\": ";
+    writeString(json, name);
+    json << ",\n";
     json << "  \"width\": " << width << ",\n";
     json << "  \"height\": " << height << ",\n";
     json << "  \"layout\": [\n";
@@ -18,7 +119,76 @@ std::string SimpleJSON::stringify(const std::vector<std::string>& maze,
         json << "\n";
     }
 
-    json << "  ]\n";
-    json << "}";
+    json << "  ]";
+    if (!costs.empty() && width > 0) {
+        json << ",\n  \"costs\": [\n";
+        for (int y = 0; y < height; ++y) {
+            json << "    [";
+            for (int x = 0; x < width; ++x) {
+                if (x > 0) json << ",";
+                json << static_cast<int>(costs[static_cast<size_t>(y) * width + x]);
+            }
+            json << "]";
+            if (y < height - 1) json << ",";
+            json << "\n";
+        }
+        json << "  ]";
+    }
+    json << "\n}";
     return json.str();
-}
\ No newline at end of file
+}
+
+bool SimpleJSON::parse(const std::string& json,
+    std::vector<std::string>& maze,
+    std::string& name,
+    std::vector<std::uint8_t>& costs) {
+    maze.clear();
+    costs.clear();
+    Reader in{ json };
+    bool hasLayout = false;
+    int costRows = 0;
+
+    if (!in.consume('{')) return false;
+    if (!in.consume('}')) {
+        do {
+            std::string key;
+            if (!in.readString(key) || !in.consume(':')) return false;
+            bool ok;
+            if (key == "name") {
+                ok = in.readString(name);
+            }
+            else if (key == "layout") {
+                hasLayout = true;
+                ok = in.readArray([&] {
+                    maze.emplace_back();
+                    return in.readString(maze.back());
+                });
+            }
+            else if (key == "costs") {
+                ok = in.readArray([&] {
+                    costRows++;
+                    return in.readArray([&] {
+                        int cost;
+                        if (!in.readInt(cost) || cost < 0 || cost > 255) return false;
+                        costs.push_back(static_cast<std::uint8_t>(cost));
+                        return true;
+                    });
+                });
+            }
+            else {
+                // width and height are implied by the layout
+                ok = in.skipValue();
+            }
+            if (!ok) return false;
+        } while (in.consume(','));
+        if (!in.consume('}')) return false;
+    }
+
+    if (!hasLayout || maze.empty()) return false;
+    for (const std::string& row : maze) {
+        if (row.size() != maze[0].size()) return false;
+    }
+    // A cost table that does not cover the grid is dropped rather than misread
+    if (costRows != static_cast<int>(maze.size()) || costs.size() != maze.size() * maze[0].size()) costs.clear();
+    return true;
+}
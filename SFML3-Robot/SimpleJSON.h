@@ -1,10 +1,21 @@
 #pragma once
+#include <cstdint>
 #include <string>
 #include <vector>
 
 class SimpleJSON {
 public:
+    // costs, when given, is one entry per cell in row-major order and is saved
+    // as one array per row
     static std::string stringify(const std::vector<std::string>& maze,
         const std::string& name,
-        int width, int height);
-};
\ No newline at end of file
+        int width, int height,
+        const std::vector<std::uint8_t>& costs = {});
+    // Reads the format stringify writes, in any key order, skipping unknown keys.
+    // costs comes back empty when the file has none. False when the text is not
+    // valid JSON or the layout is missing or ragged
+    static bool parse(const std::string& json,
+        std::vector<std::string>& maze,
+        std::string& name,
+        std::vector<std::uint8_t>& costs);
+};
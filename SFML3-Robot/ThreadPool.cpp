@@ -0,0 +1,47 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(int threadCount) {
+    if (threadCount <= 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+void ThreadPool::run(const std::function<void(int worker)>& job) {
+    std::unique_lock<std::mutex> lock(mutex);
+    current = &job;
+    busy = size();
+    ++round;
+    wake.notify_all();
+    done.wait(lock, [this] { return busy == 0; });
+    current = nullptr;
+}
+
+void ThreadPool::workerLoop(int worker) {
+    unsigned long long seen = 0;
+    while (true) {
+        const std::function<void(int)>* job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || round != seen; });
+            if (stopping) return;
+            seen = round;
+            job = current;
+        }
+        (*job)(worker);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--busy == 0) done.notify_one();
+        }
+    }
+}
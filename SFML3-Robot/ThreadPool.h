@@ -0,0 +1,32 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads that all run the same job and then park again.
+// run() hands the job to every worker and returns once each of them is done;
+// the worker index lets jobs keep per-thread scratch state.
+class ThreadPool {
+public:
+    // 0 picks std::thread::hardware_concurrency()
+    explicit ThreadPool(int threadCount = 0);
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool();
+
+    int size() const { return static_cast<int>(workers.size()); }
+    void run(const std::function<void(int worker)>& job);
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake, done;
+    const std::function<void(int)>* current = nullptr;
+    unsigned long long round = 0;
+    int busy = 0;
+    bool stopping = false;
+
+    void workerLoop(int worker);
+};
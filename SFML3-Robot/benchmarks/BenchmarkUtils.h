@@ -0,0 +1,99 @@
+#pragma once
+#include "AStar.h"
+#include "Maze.h"
+#include "Point.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// Helpers shared by the command-line benchmarks. Nothing here is part of the
+// game; every benchmark takes its sizes from the command line so it can be
+// run small as a smoke test.
+namespace Bench {
+    inline double seconds() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Best of repeats timed runs, in milliseconds, after one untimed run that
+    // warms the caches and the searches' scratch buffers
+    template <typename Run>
+    double bestMs(int repeats, Run&& run) {
+        run();
+        double best = 1e300;
+        for (int r = 0; r < repeats; ++r) {
+            double start = seconds();
+            run();
+            best = std::min(best, seconds() - start);
+        }
+        return best * 1e3;
+    }
+
+    inline int arg(int argc, char** argv, int i, int fallback) {
+        return argc > i ? std::atoi(argv[i]) : fallback;
+    }
+
+    // Scatters walls over percent of the cells; the corners stay open as start and
+    // end, and so do their neighbours, since a walled-in corner would turn every
+    // query into a search of the whole component
+    inline void scatterWalls(Maze& maze, int percent, unsigned seed) {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<int> roll(0, 99);
+        for (int y = 0; y < maze.height; ++y) {
+            for (int x = 0; x < maze.width; ++x) {
+                if (roll(gen) < percent) maze.setCell(x, y, CellType::WALL);
+            }
+        }
+        int w = maze.width, h = maze.height;
+        maze.setCell(1, 0, CellType::EMPTY);
+        maze.setCell(0, 1, CellType::EMPTY);
+        maze.setCell(w - 2, h - 1, CellType::EMPTY);
+        maze.setCell(w - 1, h - 2, CellType::EMPTY);
+        maze.setCell(0, 0, CellType::START);
+        maze.setCell(w - 1, h - 1, CellType::END);
+    }
+
+    // Square rooms of roomSize cells with a door in the middle of every wall.
+    // Sides one short of a multiple of roomSize + 1 leave no room cut off
+    inline void buildRooms(Maze& maze, int roomSize) {
+        int pitch = roomSize + 1;
+        for (int y = 0; y < maze.height; ++y) {
+            for (int x = 0; x < maze.width; ++x) {
+                bool wallRow = y % pitch == roomSize, wallColumn = x % pitch == roomSize;
+                bool door = (wallRow && x % pitch == roomSize / 2) || (wallColumn && y % pitch == roomSize / 2);
+                if ((wallRow || wallColumn) && !door) maze.setCell(x, y, CellType::WALL);
+            }
+        }
+        maze.setCell(0, 0, CellType::START);
+        maze.setCell(maze.width - 1, maze.height - 1, CellType::END);
+    }
+
+    inline const char* modeName(SearchMode mode) {
+        switch (mode) {
+        case SearchMode::ASTAR: return "A*";
+        case SearchMode::INDEXED_ASTAR: return "indexed A*";
+        case SearchMode::BUCKET_ASTAR: return "bucket A*";
+        case SearchMode::JPS: return "JPS";
+        case SearchMode::JPS_PLUS: return "JPS+";
+        case SearchMode::BIDIRECTIONAL_BFS: return "bidir BFS";
+        case SearchMode::BIDIRECTIONAL_ASTAR: return "bidir A*";
+        case SearchMode::LPA_STAR: return "LPA*";
+        case SearchMode::WEIGHTED_ASTAR: return "weighted A*";
+        }
+        return "?";
+    }
+
+    // One line per mode: expansions, best time of repeats and path length, for startPos to endPos
+    inline void compareModes(const char* label, const Maze& maze, const std::vector<SearchMode>& modes, int repeats) {
+        for (SearchMode mode : modes) {
+            PathFinder finder;
+            finder.setMode(mode);
+            std::vector<Point> path;
+            double ms = bestMs(repeats, [&] { finder.findPath(maze, maze.startPos, maze.endPos, path); });
+            std::printf("%-12s %-12s expanded %9d  pushed %9d  %9.3f ms  path %zu\n", label, modeName(mode),
+                finder.getStats().expanded, finder.getStats().pushed, ms, path.size());
+        }
+    }
+}
@@ -0,0 +1,28 @@
+#include "BenchmarkUtils.h"
+
+// Bidirectional BFS and A* against the forward A* modes, start to end, on
+// MazeGenerator corridors of 1k² and up and on a floor with random walls.
+// Usage: BidirectionalBenchmark [smallest=1001] [largest=4001] [wallPercent=30] [repeats=2]
+int main(int argc, char** argv) {
+    int smallest = Bench::arg(argc, argv, 1, 1001);
+    int largest = Bench::arg(argc, argv, 2, 4001);
+    int wallPercent = Bench::arg(argc, argv, 3, 30);
+    int repeats = Bench::arg(argc, argv, 4, 2);
+    const std::vector<SearchMode> modes = {
+        SearchMode::INDEXED_ASTAR, SearchMode::BUCKET_ASTAR, SearchMode::BIDIRECTIONAL_BFS, SearchMode::BIDIRECTIONAL_ASTAR
+    };
+
+    char label[32];
+    for (int size = smallest; size <= largest; size = size * 2 - 1) {
+        Maze corridors(size, size);
+        corridors.generateSolvableMaze();
+        std::snprintf(label, sizeof(label), "corridors %d", size);
+        Bench::compareModes(label, corridors, modes, repeats);
+    }
+
+    Maze scattered(smallest * 2, smallest * 2);
+    Bench::scatterWalls(scattered, wallPercent, 7);
+    std::snprintf(label, sizeof(label), "walls%d%% %d", wallPercent, scattered.width);
+    Bench::compareModes(label, scattered, modes, repeats);
+    return 0;
+}
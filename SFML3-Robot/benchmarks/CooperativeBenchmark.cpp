@@ -0,0 +1,72 @@
+#include "BenchmarkUtils.h"
+#include "CooperativePlanner.h"
+
+namespace {
+    // Random start and goal pairs on open cells, no two agents sharing a start or
+    // a goal, each goal reachable from its start
+    void addAgents(CooperativePlanner& planner, Maze& maze, int agents, unsigned seed) {
+        std::vector<Point> open;
+        for (int y = 0; y < maze.height; ++y) {
+            for (int x = 0; x < maze.width; ++x) {
+                if (!maze.isWall({ x, y })) open.push_back({ x, y });
+            }
+        }
+        agents = std::min(agents, static_cast<int>(open.size()));
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<size_t> pick(0, open.size() - 1);
+        std::vector<char> usedStart(maze.cellCount(), 0), usedGoal(maze.cellCount(), 0);
+        while (planner.agentCount() < agents) {
+            Point start = open[pick(gen)], goal = open[pick(gen)];
+            int s = maze.index(start.x, start.y), g = maze.index(goal.x, goal.y);
+            if (usedStart[s] || usedGoal[g] || !maze.isConnected(start, goal)) continue;
+            usedStart[s] = usedGoal[g] = 1;
+            planner.addAgent(start, goal);
+        }
+    }
+
+    void run(const char* label, Maze& maze, int agents, int steps, int window, int replanEvery) {
+        maze.enableConnectivity();
+        CooperativePlanner planner(window, replanEvery);
+        planner.attach(maze);
+        addAgents(planner, maze, agents, 9);
+
+        double start = Bench::seconds();
+        double worst = 0;
+        for (int i = 0; i < steps && planner.arrivedCount() < planner.agentCount(); ++i) {
+            double stepStart = Bench::seconds();
+            planner.step();
+            worst = std::max(worst, Bench::seconds() - stepStart);
+        }
+        double elapsed = Bench::seconds() - start;
+
+        const CooperativeStats& stats = planner.getStats();
+        double plans = static_cast<double>(std::max(1LL, stats.plans));
+        std::printf("%-8s %5d steps %9.0f plans/s %7.1f us/plan  worst step %6.2f ms  routes %lld  expanded/plan %.0f"
+            "  blocked %lld  displaced %lld  conflicts %lld  arrived %d/%d\n",
+            label, planner.getTime(), plans / elapsed, elapsed * 1e6 / plans, worst * 1e3, stats.routes,
+            stats.expanded / plans, stats.blocked, stats.displaced, stats.conflicts, planner.arrivedCount(),
+            planner.agentCount());
+    }
+}
+
+// Windowed cooperative A* driving a fleet until every agent has arrived or the
+// step budget runs out: an open floor with random walls, then a generated maze
+// whose one-cell corridors force agents to queue and give way. The generator
+// seeds itself, so the maze row changes from run to run; the floor row does not.
+// Usage: CooperativeBenchmark [size=256] [agents=200] [steps=2000] [window=16] [replanEvery=8]
+int main(int argc, char** argv) {
+    int size = Bench::arg(argc, argv, 1, 256);
+    int agents = Bench::arg(argc, argv, 2, 200);
+    int steps = Bench::arg(argc, argv, 3, 2000);
+    int window = Bench::arg(argc, argv, 4, CooperativePlanner::DEFAULT_WINDOW);
+    int replanEvery = Bench::arg(argc, argv, 5, window / 2);
+
+    Maze floor(size, size);
+    Bench::scatterWalls(floor, 20, 11);
+    run("floor", floor, agents, steps, window, replanEvery);
+
+    Maze corridors(size, size);
+    corridors.generateSolvableMaze();
+    run("maze", corridors, agents, steps, window, replanEvery);
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include "BenchmarkUtils.h"
+#include "Heuristics.h"
+
+namespace {
+    // The heuristic of every cell against the far corner, the way a search asks for it
+    template <typename Distance>
+    long long sumTemplated(int width, int height, Distance distance) {
+        Point goal{ width - 1, height - 1 };
+        long long sum = 0;
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) sum += distance({ x, y }, goal);
+        }
+        return sum;
+    }
+
+    long long sumVirtual(int width, int height, IHeuristic& heuristic) {
+        Point goal{ width - 1, height - 1 };
+        long long sum = 0;
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) sum += static_cast<long long>(heuristic.calculate({ x, y }, goal));
+        }
+        return sum;
+    }
+
+    template <typename Distance>
+    void compareCalls(const char* name, HeuristicKind kind, Distance distance, int size, int repeats) {
+        std::unique_ptr<IHeuristic> heuristic = makeHeuristic(kind);
+        long long templatedSum = 0, virtualSum = 0;
+        double templatedMs = Bench::bestMs(repeats, [&] { templatedSum = sumTemplated(size, size, distance); });
+        double virtualMs = Bench::bestMs(repeats, [&] { virtualSum = sumVirtual(size, size, *heuristic); });
+        double calls = static_cast<double>(size) * size;
+        std::printf("%-10s call   templated %6.2f ns  virtual %6.2f ns%s\n", name, templatedMs * 1e6 / calls,
+            virtualMs * 1e6 / calls, templatedSum == virtualSum ? "" : "  sums differ");
+    }
+}
+
+// What the templated heuristics save per node over the virtual IHeuristic:
+// first the bare call over every cell of a size² grid, then whole searches,
+// where classic A* asks IHeuristic and indexed A* inlines the same distance.
+// Usage: HeuristicBenchmark [size=2001] [wallPercent=25] [repeats=3]
+int main(int argc, char** argv) {
+    int size = Bench::arg(argc, argv, 1, 2001);
+    int wallPercent = Bench::arg(argc, argv, 2, 25);
+    int repeats = Bench::arg(argc, argv, 3, 3);
+
+    compareCalls("manhattan", HeuristicKind::MANHATTAN, ManhattanDistance{}, size, repeats);
+    compareCalls("zero", HeuristicKind::ZERO, ZeroDistance{}, size, repeats);
+    compareCalls("octile", HeuristicKind::OCTILE, OctileDistance{}, size, repeats);
+
+    Maze corridors(size, size);
+    corridors.generateSolvableMaze();
+    Maze scattered(size, size);
+    Bench::scatterWalls(scattered, wallPercent, 7);
+    const Maze* mazes[] = { &corridors, &scattered };
+    const char* labels[] = { "corridors", "walls" };
+    const HeuristicKind kinds[] = { HeuristicKind::MANHATTAN, HeuristicKind::ZERO, HeuristicKind::OCTILE };
+    const char* kindNames[] = { "manhattan", "zero", "octile" };
+
+    for (int m = 0; m < 2; ++m) {
+        const Maze& maze = *mazes[m];
+        for (int k = 0; k < 3; ++k) {
+            std::printf("%-10s %-10s", labels[m], kindNames[k]);
+            for (SearchMode mode : { SearchMode::ASTAR, SearchMode::INDEXED_ASTAR }) {
+                PathFinder finder;
+                finder.setMode(mode);
+                finder.setHeuristic(kinds[k]);
+                std::vector<Point> path;
+                double ms = Bench::bestMs(repeats, [&] { finder.findPath(maze, maze.startPos, maze.endPos, path); });
+                int expanded = std::max(1, finder.getStats().expanded);
+                std::printf("  %s %8d nodes %7.1f ns/node", Bench::modeName(mode), expanded, ms * 1e6 / expanded);
+            }
+            std::printf("\n");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,45 @@
+#include "BenchmarkUtils.h"
+#include "HierarchicalPathFinder.h"
+
+// HPA* on one large floor with random walls: the cost of attaching (the border
+// scan), the first query (which fills in the distances of every cluster it
+// enters), later queries, refining the first segment only, and bucket A* on
+// the same query for reference.
+// Usage: HierarchicalBenchmark [size=8192] [wallPercent=25] [clusterSize=16] [repeats=3]
+int main(int argc, char** argv) {
+    int size = Bench::arg(argc, argv, 1, 8192);
+    int wallPercent = Bench::arg(argc, argv, 2, 25);
+    int clusterSize = Bench::arg(argc, argv, 3, 16);
+    int repeats = Bench::arg(argc, argv, 4, 3);
+
+    Maze maze(size, size);
+    Bench::scatterWalls(maze, wallPercent, 7);
+    HierarchicalPathFinder hierarchy(clusterSize);
+
+    double start = Bench::seconds();
+    hierarchy.attach(maze);
+    double attachMs = (Bench::seconds() - start) * 1e3;
+    std::printf("attach        %9.1f ms  nodes %d  %.1f MB\n", attachMs, hierarchy.getNodeCount(),
+        hierarchy.memoryBytes() / 1048576.0);
+
+    start = Bench::seconds();
+    bool found = hierarchy.planAbstract(maze.startPos, maze.endPos);
+    double firstMs = (Bench::seconds() - start) * 1e3;
+    std::printf("first plan    %9.1f ms  expanded %d  waypoints %zu  %.1f MB%s\n", firstMs, hierarchy.getExpanded(),
+        hierarchy.getAbstractPath().size(), hierarchy.memoryBytes() / 1048576.0, found ? "" : "  no path");
+    if (!found) return 0;
+
+    double planMs = Bench::bestMs(repeats, [&] { hierarchy.planAbstract(maze.startPos, maze.endPos); });
+    std::vector<Point> segment;
+    double segmentMs = Bench::bestMs(repeats, [&] {
+        segment.clear();
+        hierarchy.refineSegment(0, segment);
+    });
+    std::vector<Point> path;
+    double fullMs = Bench::bestMs(repeats, [&] { hierarchy.findPath(maze.startPos, maze.endPos, path); });
+    std::printf("plan          %9.3f ms\nfirst segment %9.3f ms  cells %zu\nfull path     %9.3f ms  cells %zu\n",
+        planMs, segmentMs, segment.size(), fullMs, path.size());
+
+    Bench::compareModes("reference", maze, { SearchMode::BUCKET_ASTAR }, repeats);
+    return 0;
+}
@@ -0,0 +1,28 @@
+#include "BenchmarkUtils.h"
+
+// JPS and JPS+ against the A* modes, corner to corner, on MazeGenerator
+// corridors, on rooms joined by doors and on an empty floor.
+// Usage: JumpPointBenchmark [size=1001] [roomSize=24] [repeats=3]
+int main(int argc, char** argv) {
+    int size = Bench::arg(argc, argv, 1, 1001);
+    int roomSize = Bench::arg(argc, argv, 2, 24);
+    int repeats = Bench::arg(argc, argv, 3, 3);
+    const std::vector<SearchMode> modes = {
+        SearchMode::ASTAR, SearchMode::INDEXED_ASTAR, SearchMode::BUCKET_ASTAR, SearchMode::JPS, SearchMode::JPS_PLUS
+    };
+
+    Maze corridors(size, size);
+    corridors.generateSolvableMaze();
+    Bench::compareModes("corridors", corridors, modes, repeats);
+
+    int roomsSide = std::max(1, (size + 1) / (roomSize + 1)) * (roomSize + 1) - 1;
+    Maze rooms(roomsSide, roomsSide);
+    Bench::buildRooms(rooms, roomSize);
+    Bench::compareModes("rooms", rooms, modes, repeats);
+
+    Maze open(size, size);
+    open.setCell(0, 0, CellType::START);
+    open.setCell(size - 1, size - 1, CellType::END);
+    Bench::compareModes("open", open, modes, repeats);
+    return 0;
+}
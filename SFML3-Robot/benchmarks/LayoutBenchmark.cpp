@@ -0,0 +1,45 @@
+#include "BenchmarkUtils.h"
+#include "DistanceField.h"
+#include "SearchTask.h"
+
+// Row-major against tiled cell storage on the same floor with random walls:
+// a full BFS distance field to the end, SearchTask's A* and bucket A* from
+// start to end. Wall-clock time only; the interesting sizes are the ones whose
+// cells no longer fit in the caches.
+// Usage: LayoutBenchmark [smallest=1024] [largest=4096] [wallPercent=25] [repeats=3]
+int main(int argc, char** argv) {
+    int smallest = Bench::arg(argc, argv, 1, 1024);
+    int largest = Bench::arg(argc, argv, 2, 4096);
+    int wallPercent = Bench::arg(argc, argv, 3, 25);
+    int repeats = Bench::arg(argc, argv, 4, 3);
+
+    for (int size = smallest; size <= largest; size *= 2) {
+        for (CellLayout layout : { CellLayout::ROW_MAJOR, CellLayout::TILED }) {
+            Maze maze(size, size, layout);
+            Bench::scatterWalls(maze, wallPercent, 7);
+
+            // A field is free to update again until the maze changes, so every run gets a new one
+            int reached = 0;
+            double bfsMs = Bench::bestMs(repeats, [&] {
+                DistanceField field;
+                field.update(maze, maze.endPos);
+                reached = field.distance(maze.startPos);
+            });
+
+            SearchTask task;
+            double taskMs = Bench::bestMs(repeats, [&] {
+                task.start(maze, maze.startPos, maze.endPos);
+                while (!task.step(1 << 20)) {}
+            });
+
+            PathFinder finder;
+            finder.setMode(SearchMode::BUCKET_ASTAR);
+            std::vector<Point> path;
+            double bucketMs = Bench::bestMs(repeats, [&] { finder.findPath(maze, maze.startPos, maze.endPos, path); });
+
+            std::printf("%5d %-9s  bfs %9.2f ms  task A* %9.2f ms (%d expanded)  bucket A* %9.2f ms  distance %d\n", size,
+                layout == CellLayout::TILED ? "tiled" : "row-major", bfsMs, taskMs, task.getExpanded(), bucketMs, reached);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include "BenchmarkUtils.h"
+#include "SearchTask.h"
+#include <random>
+
+namespace {
+    // Makes percent of the open cells SPECIAL terrain, keeping start and end
+    void scatterTerrain(Maze& maze, int percent, unsigned seed) {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<int> roll(0, 99);
+        for (int y = 0; y < maze.height; ++y) {
+            for (int x = 0; x < maze.width; ++x) {
+                CellType type = maze.getCell(x, y);
+                if (type == CellType::EMPTY && roll(gen) < percent) maze.setCell(x, y, CellType::SPECIAL);
+            }
+        }
+    }
+
+    // Every open cell costs the same, which is the unit maze scaled
+    void flatTerrain(Maze& maze, std::uint8_t cost) {
+        for (int y = 0; y < maze.height; ++y) {
+            for (int x = 0; x < maze.width; ++x) maze.setCost(x, y, cost);
+        }
+    }
+
+    void run(const char* label, const Maze& maze, int repeats) {
+        PathFinder finder;
+        finder.setMode(maze.isWeighted() ? SearchMode::WEIGHTED_ASTAR : SearchMode::BUCKET_ASTAR);
+        std::vector<Point> path;
+        double ms = Bench::bestMs(repeats, [&] { finder.findPath(maze, maze.startPos, maze.endPos, path); });
+        int expanded = std::max(1, finder.getStats().expanded);
+
+        SearchTask task;
+        double taskMs = Bench::bestMs(repeats, [&] {
+            task.start(maze, maze.startPos, maze.endPos);
+            while (!task.step(1 << 20)) {}
+        });
+        int cost = 0;
+        for (size_t i = 1; i < path.size(); ++i) cost += maze.getCost(path[i].x, path[i].y);
+        int taskCost = 0;
+        for (Point p : task.getPath()) taskCost += p == maze.startPos ? 0 : maze.getCost(p.x, p.y);
+        std::printf("%-10s %-11s %9.1f ms %9d expanded %6.1f ns/node  cost %d  | task %9.1f ms  cost %d\n", label,
+            Bench::modeName(finder.getMode()), ms, expanded, ms * 1e6 / expanded, cost, taskMs, taskCost);
+    }
+}
+
+// The weighted search against the unit one on the same floor: unit costs
+// (bucket A*), every open cell at one higher cost, and SPECIAL terrain on part
+// of the open cells. SearchTask, which the path worker runs, is timed as well.
+// Usage: WeightedBenchmark [size=4096] [wallPercent=15] [terrainPercent=30] [repeats=3]
+int main(int argc, char** argv) {
+    int size = Bench::arg(argc, argv, 1, 4096);
+    int wallPercent = Bench::arg(argc, argv, 2, 15);
+    int terrainPercent = Bench::arg(argc, argv, 3, 30);
+    int repeats = Bench::arg(argc, argv, 4, 3);
+
+    Maze maze(size, size);
+    Bench::scatterWalls(maze, wallPercent, 7);
+    run("unit", maze, repeats);
+    flatTerrain(maze, Maze::SPECIAL_COST);
+    run("flat", maze, repeats);
+    flatTerrain(maze, 1);
+    scatterTerrain(maze, terrainPercent, 11);
+    run("terrain", maze, repeats);
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include "Connectivity.h"
+#include "Maze.h"
+#include <cstdio>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace {
+    int failures = 0;
+
+    void check(bool condition, const char* what) {
+        if (condition) return;
+        std::printf("FAILED: %s\n", what);
+        failures++;
+    }
+
+    bool reachable(const Maze& maze, Point a, Point b) {
+        if (maze.isWall(a) || maze.isWall(b)) return false;
+        std::vector<char> seen(maze.cellCount(), 0);
+        std::queue<Point> open;
+        open.push(a);
+        seen[maze.index(a.x, a.y)] = 1;
+        Point directions[4] = { {0,1},{0,-1},{1,0},{-1,0} };
+        while (!open.empty()) {
+            Point p = open.front();
+            open.pop();
+            if (p == b) return true;
+            for (Point d : directions) {
+                Point n = { p.x + d.x, p.y + d.y };
+                if (maze.isWall(n) || seen[maze.index(n.x, n.y)]) continue;
+                seen[maze.index(n.x, n.y)] = 1;
+                open.push(n);
+            }
+        }
+        return false;
+    }
+
+    // A reopened cell that stayed behind as the root of its old set must not
+    // drag that set along when it comes back walled in
+    void reopenedRootIsNotConnected() {
+        Maze maze(3, 3);
+        maze.enableConnectivity();
+        maze.setCell(0, 0, CellType::WALL);
+        maze.setCell(1, 0, CellType::WALL);
+        maze.setCell(0, 1, CellType::WALL);
+        maze.setCell(0, 0, CellType::EMPTY);
+        check(!maze.isConnected({ 0, 0 }, { 2, 2 }), "reopened walled-in cell joined its old component");
+        check(maze.isConnected({ 1, 1 }, { 2, 2 }), "open cells lost their component");
+    }
+
+    // Random wall flips, each answer checked against a breadth-first search
+    void randomEditsMatchSearch() {
+        Maze maze(12, 12);
+        maze.enableConnectivity();
+        std::mt19937 gen(3);
+        std::uniform_int_distribution<int> coord(0, 11);
+        int mismatches = 0;
+        for (int edit = 0; edit < 4000; ++edit) {
+            int x = coord(gen), y = coord(gen);
+            maze.setCell(x, y, maze.isWall({ x, y }) ? CellType::EMPTY : CellType::WALL);
+            Point a = { coord(gen), coord(gen) }, b = { coord(gen), coord(gen) };
+            if (maze.isConnected(a, b) != reachable(maze, a, b)) mismatches++;
+        }
+        check(mismatches == 0, "isConnected disagreed with a search after random edits");
+    }
+}
+
+int main() {
+    reopenedRootIsNotConnected();
+    randomEditsMatchSearch();
+    if (failures == 0) std::printf("ConnectivityTest passed\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+#include "CooperativePlanner.h"
+#include "Maze.h"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+    int failures = 0;
+
+    void check(bool condition, const char* what) {
+        if (condition) return;
+        std::printf("FAILED: %s\n", what);
+        failures++;
+    }
+
+    // Steps the fleet and looks for two agents in one cell or swapping cells,
+    // independently of the planner's own conflict count
+    int collisionsOver(CooperativePlanner& planner, const Maze& maze, int steps) {
+        int collisions = 0;
+        int count = planner.agentCount();
+        std::vector<int> before(count), seen(maze.cellCount(), -1), stood(maze.cellCount(), -1);
+        for (int step = 0; step < steps; ++step) {
+            for (int id = 0; id < count; ++id) {
+                Point p = planner.getPosition(id);
+                before[id] = maze.index(p.x, p.y);
+            }
+            planner.step();
+            for (int id = 0; id < count; ++id) stood[before[id]] = step * count + id;
+            for (int id = 0; id < count; ++id) {
+                Point p = planner.getPosition(id);
+                int cell = maze.index(p.x, p.y);
+                if (seen[cell] >= step * count) collisions++;
+                seen[cell] = step * count + id;
+                int other = stood[cell] >= step * count ? stood[cell] - step * count : -1;
+                if (other > id && cell != before[id]) {
+                    Point o = planner.getPosition(other);
+                    if (maze.index(o.x, o.y) == before[id]) collisions++;
+                }
+            }
+        }
+        return collisions;
+    }
+
+    // Two fleets meeting head-on in a corridor with a few passing bays
+    void headOnCorridor() {
+        Maze maze(30, 5);
+        maze.loadFromMap({
+            "##############################",
+            "#S...........................#",
+            "#.#########.#######.########.#",
+            "#...........................E#",
+            "##############################",
+        });
+        CooperativePlanner planner(8, 4);
+        planner.attach(maze);
+        for (int i = 0; i < 6; ++i) {
+            planner.addAgent({ 1 + i, 1 }, { 28 - i, 3 });
+            planner.addAgent({ 28 - i, 3 }, { 1 + i, 1 });
+        }
+        check(collisionsOver(planner, maze, 300) == 0, "agents collided in the corridor");
+        check(planner.getStats().conflicts == 0, "the planner counted conflicts in the corridor");
+    }
+
+    // More agents than one-cell corridors can carry, so blocked agents keep
+    // taking cells from the agents around them
+    void denseGeneratedMaze() {
+        for (int round = 0; round < 4; ++round) {
+            Maze maze(31, 31);
+            maze.generateSolvableMaze();
+            maze.enableConnectivity();
+            std::vector<Point> open;
+            for (int y = 0; y < maze.height; ++y) {
+                for (int x = 0; x < maze.width; ++x) {
+                    if (!maze.isWall({ x, y })) open.push_back({ x, y });
+                }
+            }
+            CooperativePlanner planner;
+            planner.attach(maze);
+            std::mt19937 gen(5 + round);
+            std::uniform_int_distribution<size_t> pick(0, open.size() - 1);
+            std::vector<char> usedStart(maze.cellCount(), 0), usedGoal(maze.cellCount(), 0);
+            while (planner.agentCount() < 150) {
+                Point start = open[pick(gen)], goal = open[pick(gen)];
+                int s = maze.index(start.x, start.y), g = maze.index(goal.x, goal.y);
+                if (usedStart[s] || usedGoal[g] || !maze.isConnected(start, goal)) continue;
+                usedStart[s] = usedGoal[g] = 1;
+                planner.addAgent(start, goal);
+            }
+            check(collisionsOver(planner, maze, 300) == 0, "agents collided in a dense maze");
+            check(planner.getStats().conflicts == 0, "the planner counted conflicts in a dense maze");
+        }
+    }
+}
+
+int main() {
+    headOnCorridor();
+    denseGeneratedMaze();
+    if (failures == 0) std::printf("CooperativePlannerTest passed\n");
+    return failures == 0 ? 0 : 1;
+}